@@ -2,6 +2,7 @@
 #define LULESH_COMM
 #include "lulesh.h"
 #include <vector>
+#include <algorithm>
 
 // If no MPI, then this whole file is stubbed out
 #if USE_MPI
@@ -57,16 +58,140 @@
 
 /******************************************/
 
+/* Faces and edges are copied between a field and a message buffer as
+   count blocks of blocklength values, stride values apart.  With EMPI
+   the copies go through its vectorized pack/unpack kernels. */
+
+static inline void CommPack(const Real_t *field, Real_t *buf,
+                            Index_t count, Index_t blocklength, Index_t stride)
+{
+#if defined(USE_EMPI)
+   empi::pack(field, buf, count, blocklength, stride) ;
+#else
+   for (Index_t i=0; i<count; ++i) {
+      for (Index_t j=0; j<blocklength; ++j) {
+         buf[i*blocklength + j] = field[i*stride + j] ;
+      }
+   }
+#endif
+}
+
+static inline void CommUnpack(const Real_t *buf, Real_t *field,
+                              Index_t count, Index_t blocklength, Index_t stride)
+{
+#if defined(USE_EMPI)
+   empi::unpack(buf, field, count, blocklength, stride) ;
+#else
+   for (Index_t i=0; i<count; ++i) {
+      for (Index_t j=0; j<blocklength; ++j) {
+         field[i*stride + j] = buf[i*blocklength + j] ;
+      }
+   }
+#endif
+}
+
+static inline void CommUnpackAdd(const Real_t *buf, Real_t *field,
+                                 Index_t count, Index_t blocklength, Index_t stride)
+{
+#if defined(USE_EMPI)
+   empi::unpack_add(buf, field, count, blocklength, stride) ;
+#else
+   for (Index_t i=0; i<count; ++i) {
+      for (Index_t j=0; j<blocklength; ++j) {
+         field[i*stride + j] += buf[i*blocklength + j] ;
+      }
+   }
+#endif
+}
+
+/******************************************/
+
+#if defined(USE_EMPI)
+/* With EMPI all the face, edge and corner messages of an exchange travel
+   in a single neighborhood collective over the graph of adjacent domains
+   (see CommNeighbors).  CommRecv and CommSend only record the size and
+   buffer offset of the message for each neighbor, CommSend starts the
+   exchange and the unpack routines wait for it. */
+struct CommHaloExchange {
+   std::vector<int> neighbors ;
+   std::vector<int> recvCount, recvDispl ;
+   std::vector<int> sendCount, sendDispl ;
+   empi::async_event event ;
+} ;
+
+static CommHaloExchange halo ;
+
+static inline Index_t CommNeighborIndex(int rank)
+{
+   return Index_t(std::find(halo.neighbors.begin(), halo.neighbors.end(), rank) -
+                  halo.neighbors.begin()) ;
+}
+
+static inline void CommHaloRecv(Domain& domain, Real_t *addr, int fromRank, int count)
+{
+   Index_t n = CommNeighborIndex(fromRank) ;
+   halo.recvCount[n] = count ;
+   halo.recvDispl[n] = int(addr - domain.commDataRecv) ;
+}
+
+static inline void CommHaloSend(Domain& domain, Real_t *addr, int toRank, int count)
+{
+   Index_t n = CommNeighborIndex(toRank) ;
+   halo.sendCount[n] = count ;
+   halo.sendDispl[n] = int(addr - domain.commDataSend) ;
+}
+
+/* Trace region (see USE_EMPI_TRACE) of the packing and posting of an
+   exchange; the unpack routines open one named after themselves */
+static inline const char *CommSendRegion(Int_t msgType)
+{
+   switch (msgType) {
+      case MSG_COMM_SBN:     return "CommSBN.send" ;
+      case MSG_SYNC_POS_VEL: return "CommSyncPosVel.send" ;
+      case MSG_MONOQ:        return "CommMonoQ.send" ;
+      default:               return "CommSend" ;
+   }
+}
+
+/* Ranks of the (up to 26) domains sharing a face, an edge or a corner
+   with this one: both the sources and the destinations of the graph */
+std::vector<int> CommNeighbors(Domain& domain)
+{
+   int myRank ;
+   Index_t tp = domain.tp() ;
+   MPI_Comm_rank(MPI_COMM_WORLD, &myRank) ;
+
+   halo.neighbors.clear() ;
+   for (Index_t dp=-1; dp<=1; ++dp) {
+      for (Index_t dr=-1; dr<=1; ++dr) {
+         for (Index_t dc=-1; dc<=1; ++dc) {
+            Index_t plane = domain.planeLoc() + dp ;
+            Index_t row = domain.rowLoc() + dr ;
+            Index_t col = domain.colLoc() + dc ;
+            if ((dp == 0 && dr == 0 && dc == 0) ||
+                plane < 0 || plane >= tp || row < 0 || row >= tp || col < 0 || col >= tp) {
+               continue ;
+            }
+            halo.neighbors.push_back(myRank + dp*tp*tp + dr*tp + dc) ;
+         }
+      }
+   }
+   halo.recvCount.assign(halo.neighbors.size(), 0) ;
+   halo.recvDispl.assign(halo.neighbors.size(), 0) ;
+   halo.sendCount.assign(halo.neighbors.size(), 0) ;
+   halo.sendDispl.assign(halo.neighbors.size(), 0) ;
+   return halo.neighbors ;
+}
+#endif
+
+/******************************************/
+
 
 /* doRecv flag only works with regular block structure */
 #if defined(USE_MPL_CXX)
 void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
               Index_t dx, Index_t dy, Index_t dz, bool doRecv, bool planeOnly, 
               std::vector<mpl::irequest>& rpool)
-#elif defined(USE_EMPI)
-void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
-              Index_t dx, Index_t dy, Index_t dz, bool doRecv, bool planeOnly, 
-              std::vector<empi::async_event_p>& rpool, std::unique_ptr<empi::MessageGroup>& comm_world)
 #else
 void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
               Index_t dx, Index_t dy, Index_t dz, bool doRecv, bool planeOnly)
@@ -105,7 +230,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
    Int4_t ly  = dy*xferFields;  
    Int4_t l   = xferFields;  
    
-   empi::Tag rtag{msgType};
+   std::fill(halo.recvCount.begin(), halo.recvCount.end(), 0) ;
 #endif
 
    /* assume communication to 6 neighbors by default */
@@ -148,7 +273,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
       rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm], 
             lxy, fromRank, rtag));
 #elif defined(USE_EMPI)
-      rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm], fromRank, lxy , rtag));
+      CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm], fromRank, lxy) ;
 #else
       MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm],
                 recvCount, baseType, fromRank, msgType,
@@ -164,7 +289,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
       rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm], 
             lxy, fromRank, rtag));
 #elif defined(USE_EMPI)
-      rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm], fromRank, lxy, rtag));
+      CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm], fromRank, lxy) ;
 #else
       MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm],
                 recvCount, baseType, fromRank, msgType,
@@ -180,7 +305,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
       rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm], 
             lxz, fromRank, rtag));
 #elif defined(USE_EMPI)
-      rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm], fromRank, lxz, rtag));
+      CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm], fromRank, lxz) ;
 #else
       MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm],
                 recvCount, baseType, fromRank, msgType,
@@ -196,7 +321,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
       rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm], 
             lxz, fromRank, rtag));
 #elif defined(USE_EMPI)
-      rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm], fromRank,lxz, rtag));
+      CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm], fromRank, lxz) ;
 #else
       MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm],
                 recvCount, baseType, fromRank, msgType,
@@ -212,7 +337,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
       rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm], 
             lyz, fromRank, rtag));
 #elif defined(USE_EMPI)
-      rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm], fromRank,lyz, rtag));
+      CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm], fromRank, lyz) ;
 #else
       MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm],
                 recvCount, baseType, fromRank, msgType,
@@ -228,7 +353,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
       rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm], 
             lyz, fromRank, rtag));
 #elif defined(USE_EMPI)
-      rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm], fromRank,lyz, rtag));
+      CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm], fromRank, lyz) ;
 #else
       MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm],
                 recvCount, baseType, fromRank, msgType,
@@ -245,7 +370,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                lz, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank,lz, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, lz) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -261,7 +386,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                lx, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm],  fromRank,lx, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, lx) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -277,7 +402,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                ly, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, ly, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, ly) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -293,7 +418,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                lz, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank,lz, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, lz) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -309,7 +434,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                lx, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm],  fromRank,lx, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, lx) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -325,7 +450,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                ly, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm],  fromRank,ly, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, ly) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -341,7 +466,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                lz, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm],  fromRank,lz, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, lz) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -357,7 +482,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                lx, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm],  fromRank,lx, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, lx) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -373,7 +498,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                ly, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm],  fromRank,ly, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, ly) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -389,7 +514,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                lz, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank,lz, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, lz) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -405,7 +530,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                lx, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank,lx, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, lx) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -421,7 +546,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
          rpool.push_back(comm_world.irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], 
                ly, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank,ly, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm + emsg * maxEdgeComm], fromRank, ly) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm],
@@ -441,10 +566,10 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
                                                           cmsg * CACHE_COHERENCE_PAD_REAL], 
                                                           l, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + 
-                                                          emsg * maxEdgeComm + 
-                                                          cmsg * CACHE_COHERENCE_PAD_REAL], 
-                                                          fromRank,l, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm +
+                                                   emsg * maxEdgeComm +
+                                                   cmsg * CACHE_COHERENCE_PAD_REAL],
+                      fromRank, l) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm +
@@ -463,10 +588,10 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
                                                           cmsg * CACHE_COHERENCE_PAD_REAL], 
                                                           l, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + 
-                                                          emsg * maxEdgeComm + 
-                                                          cmsg * CACHE_COHERENCE_PAD_REAL], 
-                                                          fromRank,l, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm +
+                                                   emsg * maxEdgeComm +
+                                                   cmsg * CACHE_COHERENCE_PAD_REAL],
+                      fromRank, l) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm +
@@ -485,10 +610,10 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
                                                           cmsg * CACHE_COHERENCE_PAD_REAL], 
                                                           l, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + 
-                                                          emsg * maxEdgeComm + 
-                                                          cmsg * CACHE_COHERENCE_PAD_REAL], 
-                                                          fromRank,l, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm +
+                                                   emsg * maxEdgeComm +
+                                                   cmsg * CACHE_COHERENCE_PAD_REAL],
+                      fromRank, l) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm +
@@ -507,10 +632,10 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
                                                           cmsg * CACHE_COHERENCE_PAD_REAL], 
                                                           l, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + 
-                                                          emsg * maxEdgeComm + 
-                                                          cmsg * CACHE_COHERENCE_PAD_REAL], 
-                                                          fromRank,l, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm +
+                                                   emsg * maxEdgeComm +
+                                                   cmsg * CACHE_COHERENCE_PAD_REAL],
+                      fromRank, l) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm +
@@ -529,10 +654,10 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
                                                           cmsg * CACHE_COHERENCE_PAD_REAL], 
                                                           l, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + 
-                                                          emsg * maxEdgeComm + 
-                                                          cmsg * CACHE_COHERENCE_PAD_REAL], 
-                                                          fromRank,l, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm +
+                                                   emsg * maxEdgeComm +
+                                                   cmsg * CACHE_COHERENCE_PAD_REAL],
+                      fromRank, l) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm +
@@ -551,10 +676,10 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
                                                           cmsg * CACHE_COHERENCE_PAD_REAL], 
                                                           l, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + 
-                                                          emsg * maxEdgeComm + 
-                                                          cmsg * CACHE_COHERENCE_PAD_REAL], 
-                                                          fromRank,l, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm +
+                                                   emsg * maxEdgeComm +
+                                                   cmsg * CACHE_COHERENCE_PAD_REAL],
+                      fromRank, l) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm +
@@ -573,10 +698,10 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
                                                           cmsg * CACHE_COHERENCE_PAD_REAL], 
                                                           l, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + 
-                                                          emsg * maxEdgeComm + 
-                                                          cmsg * CACHE_COHERENCE_PAD_REAL], 
-                                                          fromRank,l, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm +
+                                                   emsg * maxEdgeComm +
+                                                   cmsg * CACHE_COHERENCE_PAD_REAL],
+                      fromRank, l) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm +
@@ -595,10 +720,10 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
                                                           cmsg * CACHE_COHERENCE_PAD_REAL], 
                                                           l, fromRank, rtag));
 #elif defined(USE_EMPI)
-         rpool.push_back(comm_world->Irecv(&domain.commDataRecv[pmsg * maxPlaneComm + 
-                                                          emsg * maxEdgeComm + 
-                                                          cmsg * CACHE_COHERENCE_PAD_REAL], 
-                                                          fromRank,l, rtag));
+         CommHaloRecv(domain, &domain.commDataRecv[pmsg * maxPlaneComm +
+                                                   emsg * maxEdgeComm +
+                                                   cmsg * CACHE_COHERENCE_PAD_REAL],
+                      fromRank, l) ;
 #else
          MPI_Irecv(&domain.commDataRecv[pmsg * maxPlaneComm +
                                          emsg * maxEdgeComm +
@@ -615,7 +740,7 @@ void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
 #if defined(USE_EMPI)
 void CommSend(Domain& domain, Int_t msgType,
               Index_t xferFields, Domain_member *fieldData,
-              Index_t dx, Index_t dy, Index_t dz, bool doSend, bool planeOnly, std::unique_ptr<empi::MessageGroup>& comm_world)
+              Index_t dx, Index_t dy, Index_t dz, bool doSend, bool planeOnly, std::unique_ptr<lulesh_group>& comm_world)
 #else
 void CommSend(Domain& domain, Int_t msgType,
               Index_t xferFields, Domain_member *fieldData,
@@ -626,6 +751,10 @@ void CommSend(Domain& domain, Int_t msgType,
    if (domain.numRanks() == 1)
       return ;
 
+#if defined(USE_EMPI)
+   lulesh_trace::region region(CommSendRegion(msgType)) ;
+#endif
+
    /* post recieve buffers for all incoming messages */
    int myRank ;
    Index_t maxPlaneComm = xferFields * domain.maxPlaneSize() ;
@@ -685,8 +814,7 @@ void CommSend(Domain& domain, Int_t msgType,
    Int4_t ly  = xferFields*dy;  
    Int4_t l   = xferFields;  
    
-   std::vector<empi::async_event_p> spool;
-   empi::Tag stag{msgType};
+   std::fill(halo.sendCount.begin(), halo.sendCount.end(), 0) ;
 #endif
 
    /* post sends */
@@ -699,16 +827,14 @@ void CommSend(Domain& domain, Int_t msgType,
          destAddr = &domain.commDataSend[pmsg * maxPlaneComm] ;
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<sendCount; ++i) {
-               destAddr[i] = (domain.*src)(i) ;
-            }
+            CommPack(&(domain.*src)(0), destAddr, sendCount, 1, 1) ;
             destAddr += sendCount ;
          }
          destAddr -= xferFields*sendCount ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lxy, myRank - domain.tp()*domain.tp(), stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, myRank - domain.tp()*domain.tp(),lxy, stag));
+         CommHaloSend(domain, destAddr, myRank - domain.tp()*domain.tp(), lxy) ;
 #else
          MPI_Isend(destAddr, xferFields*sendCount, baseType,
                    myRank - domain.tp()*domain.tp(), msgType,
@@ -720,16 +846,14 @@ void CommSend(Domain& domain, Int_t msgType,
          destAddr = &domain.commDataSend[pmsg * maxPlaneComm] ;
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<sendCount; ++i) {
-               destAddr[i] = (domain.*src)(dx*dy*(dz - 1) + i) ;
-            }
+            CommPack(&(domain.*src)(dx*dy*(dz - 1)), destAddr, sendCount, 1, 1) ;
             destAddr += sendCount ;
          }
          destAddr -= xferFields*sendCount ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lxy, myRank + domain.tp()*domain.tp(), stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, myRank + domain.tp()*domain.tp(),lxy, stag));
+         CommHaloSend(domain, destAddr, myRank + domain.tp()*domain.tp(), lxy) ;
 #else
          MPI_Isend(destAddr, xferFields*sendCount, baseType,
                    myRank + domain.tp()*domain.tp(), msgType,
@@ -746,18 +870,14 @@ void CommSend(Domain& domain, Int_t msgType,
          destAddr = &domain.commDataSend[pmsg * maxPlaneComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dx; ++j) {
-                  destAddr[i*dx+j] = (domain.*src)(i*dx*dy + j) ;
-               }
-            }
+            CommPack(&(domain.*src)(0), destAddr, dz, dx, dx*dy) ;
             destAddr += sendCount ;
          }
          destAddr -= xferFields*sendCount ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lxz, myRank - domain.tp(), stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, myRank - domain.tp(), lxz, stag));
+         CommHaloSend(domain, destAddr, myRank - domain.tp(), lxz) ;
 #else
          MPI_Isend(destAddr, xferFields*sendCount, baseType,
                    myRank - domain.tp(), msgType,
@@ -769,18 +889,14 @@ void CommSend(Domain& domain, Int_t msgType,
          destAddr = &domain.commDataSend[pmsg * maxPlaneComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dx; ++j) {
-                  destAddr[i*dx+j] = (domain.*src)(dx*(dy - 1) + i*dx*dy + j) ;
-               }
-            }
+            CommPack(&(domain.*src)(dx*(dy - 1)), destAddr, dz, dx, dx*dy) ;
             destAddr += sendCount ;
          }
          destAddr -= xferFields*sendCount ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lxz, myRank + domain.tp(), stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, myRank + domain.tp(), lxz, stag));
+         CommHaloSend(domain, destAddr, myRank + domain.tp(), lxz) ;
 #else
          MPI_Isend(destAddr, xferFields*sendCount, baseType,
                    myRank + domain.tp(), msgType,
@@ -797,18 +913,14 @@ void CommSend(Domain& domain, Int_t msgType,
          destAddr = &domain.commDataSend[pmsg * maxPlaneComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dy; ++j) {
-                  destAddr[i*dy + j] = (domain.*src)(i*dx*dy + j*dx) ;
-               }
-            }
+            CommPack(&(domain.*src)(0), destAddr, dz*dy, 1, dx) ;
             destAddr += sendCount ;
          }
          destAddr -= xferFields*sendCount ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lyz, myRank - 1, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, myRank - 1, lyz, stag));
+         CommHaloSend(domain, destAddr, myRank - 1, lyz) ;
 #else
          MPI_Isend(destAddr, xferFields*sendCount, baseType,
                    myRank - 1, msgType,
@@ -820,18 +932,14 @@ void CommSend(Domain& domain, Int_t msgType,
          destAddr = &domain.commDataSend[pmsg * maxPlaneComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dy; ++j) {
-                  destAddr[i*dy + j] = (domain.*src)(dx - 1 + i*dx*dy + j*dx) ;
-               }
-            }
+            CommPack(&(domain.*src)(dx - 1), destAddr, dz*dy, 1, dx) ;
             destAddr += sendCount ;
          }
          destAddr -= xferFields*sendCount ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lyz, myRank + 1, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, myRank + 1, lyz, stag));
+         CommHaloSend(domain, destAddr, myRank + 1, lyz) ;
 #else
          MPI_Isend(destAddr, xferFields*sendCount, baseType,
                    myRank + 1, msgType,
@@ -848,16 +956,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               destAddr[i] = (domain.*src)(i*dx*dy) ;
-            }
+            CommPack(&(domain.*src)(0), destAddr, dz, 1, dx*dy) ;
             destAddr += dz ;
          }
          destAddr -= xferFields*dz ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lz, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, lz, stag));
+         CommHaloSend(domain, destAddr, toRank, lz) ;
 #else
          MPI_Isend(destAddr, xferFields*dz, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -871,16 +977,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dx; ++i) {
-               destAddr[i] = (domain.*src)(i) ;
-            }
+            CommPack(&(domain.*src)(0), destAddr, dx, 1, 1) ;
             destAddr += dx ;
          }
          destAddr -= xferFields*dx ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lx, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, lx, stag));
+         CommHaloSend(domain, destAddr, toRank, lx) ;
 #else
          MPI_Isend(destAddr, xferFields*dx, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -894,16 +998,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dy; ++i) {
-               destAddr[i] = (domain.*src)(i*dx) ;
-            }
+            CommPack(&(domain.*src)(0), destAddr, dy, 1, dx) ;
             destAddr += dy ;
          }
          destAddr -= xferFields*dy ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, ly, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, ly, stag));
+         CommHaloSend(domain, destAddr, toRank, ly) ;
 #else
          MPI_Isend(destAddr, xferFields*dy, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -917,16 +1019,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               destAddr[i] = (domain.*src)(dx*dy - 1 + i*dx*dy) ;
-            }
+            CommPack(&(domain.*src)(dx*dy - 1), destAddr, dz, 1, dx*dy) ;
             destAddr += dz ;
          }
          destAddr -= xferFields*dz ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lz, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, lz, stag));
+         CommHaloSend(domain, destAddr, toRank, lz) ;
 #else
          MPI_Isend(destAddr, xferFields*dz, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -940,16 +1040,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dx; ++i) {
-              destAddr[i] = (domain.*src)(dx*(dy-1) + dx*dy*(dz-1) + i) ;
-            }
+            CommPack(&(domain.*src)(dx*(dy-1) + dx*dy*(dz-1)), destAddr, dx, 1, 1) ;
             destAddr += dx ;
          }
          destAddr -= xferFields*dx ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lx, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, lx, stag));
+         CommHaloSend(domain, destAddr, toRank, lx) ;
 #else
          MPI_Isend(destAddr, xferFields*dx, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -963,16 +1061,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dy; ++i) {
-               destAddr[i] = (domain.*src)(dx*dy*(dz-1) + dx - 1 + i*dx) ;
-            }
+            CommPack(&(domain.*src)(dx*dy*(dz-1) + dx - 1), destAddr, dy, 1, dx) ;
             destAddr += dy ;
          }
          destAddr -= xferFields*dy ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, ly, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, ly, stag));
+         CommHaloSend(domain, destAddr, toRank, ly) ;
 #else
          MPI_Isend(destAddr, xferFields*dy, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -986,16 +1082,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               destAddr[i] = (domain.*src)(dx*(dy-1) + i*dx*dy) ;
-            }
+            CommPack(&(domain.*src)(dx*(dy-1)), destAddr, dz, 1, dx*dy) ;
             destAddr += dz ;
          }
          destAddr -= xferFields*dz ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lz, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, lz, stag));
+         CommHaloSend(domain, destAddr, toRank, lz) ;
 #else
          MPI_Isend(destAddr, xferFields*dz, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -1009,16 +1103,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dx; ++i) {
-               destAddr[i] = (domain.*src)(dx*dy*(dz-1) + i) ;
-            }
+            CommPack(&(domain.*src)(dx*dy*(dz-1)), destAddr, dx, 1, 1) ;
             destAddr += dx ;
          }
          destAddr -= xferFields*dx ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lx, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, lx, stag));
+         CommHaloSend(domain, destAddr, toRank, lx) ;
 #else
          MPI_Isend(destAddr, xferFields*dx, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -1032,16 +1124,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dy; ++i) {
-               destAddr[i] = (domain.*src)(dx*dy*(dz-1) + i*dx) ;
-            }
+            CommPack(&(domain.*src)(dx*dy*(dz-1)), destAddr, dy, 1, dx) ;
             destAddr += dy ;
          }
          destAddr -= xferFields*dy ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, ly, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, ly, stag));
+         CommHaloSend(domain, destAddr, toRank, ly) ;
 #else
          MPI_Isend(destAddr, xferFields*dy, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -1055,16 +1145,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               destAddr[i] = (domain.*src)(dx - 1 + i*dx*dy) ;
-            }
+            CommPack(&(domain.*src)(dx - 1), destAddr, dz, 1, dx*dy) ;
             destAddr += dz ;
          }
          destAddr -= xferFields*dz ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lz, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, lz, stag));
+         CommHaloSend(domain, destAddr, toRank, lz) ;
 #else
          MPI_Isend(destAddr, xferFields*dz, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -1078,16 +1166,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dx; ++i) {
-               destAddr[i] = (domain.*src)(dx*(dy - 1) + i) ;
-            }
+            CommPack(&(domain.*src)(dx*(dy - 1)), destAddr, dx, 1, 1) ;
             destAddr += dx ;
          }
          destAddr -= xferFields*dx ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, lx, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, lx, stag));
+         CommHaloSend(domain, destAddr, toRank, lx) ;
 #else
          MPI_Isend(destAddr, xferFields*dx, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -1101,16 +1187,14 @@ void CommSend(Domain& domain, Int_t msgType,
                                           emsg * maxEdgeComm] ;
          for (Index_t fi=0; fi<xferFields; ++fi) {
             Domain_member src = fieldData[fi] ;
-            for (Index_t i=0; i<dy; ++i) {
-               destAddr[i] = (domain.*src)(dx - 1 + i*dx) ;
-            }
+            CommPack(&(domain.*src)(dx - 1), destAddr, dy, 1, dx) ;
             destAddr += dy ;
          }
          destAddr -= xferFields*dy ;
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(destAddr, ly, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(destAddr, toRank, ly, stag));
+         CommHaloSend(domain, destAddr, toRank, ly) ;
 #else
          MPI_Isend(destAddr, xferFields*dy, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg]) ;
@@ -1130,7 +1214,7 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(comBuf, l, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(comBuf, toRank, l, stag));
+         CommHaloSend(domain, comBuf, toRank, l) ;
 #else
          MPI_Isend(comBuf, xferFields, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg+cmsg]) ;
@@ -1150,7 +1234,7 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(comBuf, l, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(comBuf, toRank, l, stag));
+         CommHaloSend(domain, comBuf, toRank, l) ;
 #else
          MPI_Isend(comBuf, xferFields, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg+cmsg]) ;
@@ -1170,7 +1254,7 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(comBuf, l, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(comBuf, toRank, l, stag));
+         CommHaloSend(domain, comBuf, toRank, l) ;
 #else
          MPI_Isend(comBuf, xferFields, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg+cmsg]) ;
@@ -1190,7 +1274,7 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(comBuf, l, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(comBuf, toRank, l, stag));
+         CommHaloSend(domain, comBuf, toRank, l) ;
 #else
          MPI_Isend(comBuf, xferFields, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg+cmsg]) ;
@@ -1210,7 +1294,7 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(comBuf, l, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(comBuf, toRank, l, stag));
+         CommHaloSend(domain, comBuf, toRank, l) ;
 #else
          MPI_Isend(comBuf, xferFields, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg+cmsg]) ;
@@ -1230,7 +1314,7 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(comBuf, l, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(comBuf, toRank, l, stag));
+         CommHaloSend(domain, comBuf, toRank, l) ;
 #else
          MPI_Isend(comBuf, xferFields, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg+cmsg]) ;
@@ -1250,7 +1334,7 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(comBuf, l, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(comBuf, toRank, l, stag));
+         CommHaloSend(domain, comBuf, toRank, l) ;
 #else
          MPI_Isend(comBuf, xferFields, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg+cmsg]) ;
@@ -1270,7 +1354,7 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
          spool.push(comm_world.isend(comBuf, l, toRank, stag));
 #elif defined(USE_EMPI)
-         spool.push_back(comm_world->Isend(comBuf, toRank, l, stag));
+         CommHaloSend(domain, comBuf, toRank, l) ;
 #else
          MPI_Isend(comBuf, xferFields, baseType, toRank, msgType,
                    MPI_COMM_WORLD, &domain.sendRequest[pmsg+emsg+cmsg]) ;
@@ -1281,10 +1365,10 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
    spool.waitall();
 #elif defined(USE_EMPI)
-   #pragma unroll
-   for(auto& req : spool){
-      MPI_Wait(req->get_request(), MPI_STATUS_IGNORE);
-   }
+   /* every message of the exchange leaves in one neighborhood collective,
+      the unpack routines wait for it */
+   halo.event = comm_world->Ineighbor_alltoallv(domain.commDataSend, halo.sendCount.data(), halo.sendDispl.data(),
+                                                domain.commDataRecv, halo.recvCount.data(), halo.recvDispl.data()) ;
 #else
    MPI_Waitall(26, domain.sendRequest, status) ;
 #endif
@@ -1294,7 +1378,7 @@ void CommSend(Domain& domain, Int_t msgType,
 #if defined(USE_MPL_CXX)
 void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData, std::vector<mpl::irequest>&  rpool)
 #elif defined(USE_EMPI)
-void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData, std::vector<empi::async_event_p>&  rpool, std::unique_ptr<empi::MessageGroup>& comm_world)
+void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData, std::unique_ptr<lulesh_group>& comm_world)
 #else
 void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData) 
 #endif
@@ -1302,6 +1386,13 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
    if (domain.numRanks() == 1)
       return ;
 
+#if defined(USE_EMPI)
+   lulesh_trace::region region("CommSBN") ;
+   /* Complete the exchange on every rank, also on those that unpack from
+      fewer neighbors, before the next CommRecv/CommSend reuse its buffers */
+   comm_world->wait(halo.event) ;
+#endif
+
    /* summation order should be from smallest value to largest */
    /* or we could try out kahan summation! */
 
@@ -1314,8 +1405,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
    Index_t dx = domain.sizeX() + 1 ;
    Index_t dy = domain.sizeY() + 1 ;
    Index_t dz = domain.sizeZ() + 1 ;
-#if defined(USE_MPL_CXX)
-#else
+#if !defined(USE_MPL_CXX) && !defined(USE_EMPI)
    MPI_Status status ;
 #endif
    Real_t *srcAddr ;
@@ -1350,16 +1440,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<opCount; ++i) {
-               (domain.*dest)(i) += srcAddr[i] ;
-            }
+            CommUnpackAdd(srcAddr, &(domain.*dest)(0), opCount, 1, 1) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -1369,16 +1455,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<opCount; ++i) {
-               (domain.*dest)(dx*dy*(dz - 1) + i) += srcAddr[i] ;
-            }
+            CommUnpackAdd(srcAddr, &(domain.*dest)(dx*dy*(dz - 1)), opCount, 1, 1) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -1394,18 +1476,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dx; ++j) {
-                  (domain.*dest)(i*dx*dy + j) += srcAddr[i*dx + j] ;
-               }
-            }
+            CommUnpackAdd(srcAddr, &(domain.*dest)(0), dz, dx, dx*dy) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -1415,18 +1491,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dx; ++j) {
-                  (domain.*dest)(dx*(dy - 1) + i*dx*dy + j) += srcAddr[i*dx + j] ;
-               }
-            }
+            CommUnpackAdd(srcAddr, &(domain.*dest)(dx*(dy - 1)), dz, dx, dx*dy) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -1441,18 +1511,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dy; ++j) {
-                  (domain.*dest)(i*dx*dy + j*dx) += srcAddr[i*dy + j] ;
-               }
-            }
+            CommUnpackAdd(srcAddr, &(domain.*dest)(0), dz*dy, 1, dx) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -1462,18 +1526,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dy; ++j) {
-                  (domain.*dest)(dx - 1 + i*dx*dy + j*dx) += srcAddr[i*dy + j] ;
-               }
-            }
+            CommUnpackAdd(srcAddr, &(domain.*dest)(dx - 1), dz*dy, 1, dx) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -1485,16 +1543,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;      
 #if defined(USE_MPL_CXX)
          rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dz; ++i) {
-            (domain.*dest)(i*dx*dy) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(0), dz, 1, dx*dy) ;
          srcAddr += dz ;
       }
       ++emsg ;
@@ -1505,16 +1559,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else     
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dx; ++i) {
-            (domain.*dest)(i) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(0), dx, 1, 1) ;
          srcAddr += dx ;
       }
       ++emsg ;
@@ -1525,16 +1575,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dy; ++i) {
-            (domain.*dest)(i*dx) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(0), dy, 1, dx) ;
          srcAddr += dy ;
       }
       ++emsg ;
@@ -1545,16 +1591,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dz; ++i) {
-            (domain.*dest)(dx*dy - 1 + i*dx*dy) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(dx*dy - 1), dz, 1, dx*dy) ;
          srcAddr += dz ;
       }
       ++emsg ;
@@ -1565,16 +1607,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else      
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dx; ++i) {
-            (domain.*dest)(dx*(dy-1) + dx*dy*(dz-1) + i) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(dx*(dy-1) + dx*dy*(dz-1)), dx, 1, 1) ;
          srcAddr += dx ;
       }
       ++emsg ;
@@ -1585,16 +1623,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else      
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dy; ++i) {
-            (domain.*dest)(dx*dy*(dz-1) + dx - 1 + i*dx) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(dx*dy*(dz-1) + dx - 1), dy, 1, dx) ;
          srcAddr += dy ;
       }
       ++emsg ;
@@ -1605,16 +1639,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dz; ++i) {
-            (domain.*dest)(dx*(dy-1) + i*dx*dy) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(dx*(dy-1)), dz, 1, dx*dy) ;
          srcAddr += dz ;
       }
       ++emsg ;
@@ -1625,16 +1655,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dx; ++i) {
-            (domain.*dest)(dx*dy*(dz-1) + i) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(dx*dy*(dz-1)), dx, 1, 1) ;
          srcAddr += dx ;
       }
       ++emsg ;
@@ -1645,16 +1671,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dy; ++i) {
-            (domain.*dest)(dx*dy*(dz-1) + i*dx) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(dx*dy*(dz-1)), dy, 1, dx) ;
          srcAddr += dy ;
       }
       ++emsg ;
@@ -1665,16 +1687,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dz; ++i) {
-            (domain.*dest)(dx - 1 + i*dx*dy) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(dx - 1), dz, 1, dx*dy) ;
          srcAddr += dz ;
       }
       ++emsg ;
@@ -1685,16 +1703,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dx; ++i) {
-            (domain.*dest)(dx*(dy - 1) + i) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(dx*(dy - 1)), dx, 1, 1) ;
          srcAddr += dx ;
       }
       ++emsg ;
@@ -1705,16 +1719,12 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dy; ++i) {
-            (domain.*dest)(dx - 1 + i*dx) += srcAddr[i] ;
-         }
+         CommUnpackAdd(srcAddr, &(domain.*dest)(dx - 1), dy, 1, dx) ;
          srcAddr += dy ;
       }
       ++emsg ;
@@ -1727,9 +1737,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
                                       cmsg * CACHE_COHERENCE_PAD_REAL] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -1745,9 +1753,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
       Index_t idx = dx*dy*(dz - 1) ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else      
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -1763,9 +1769,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
       Index_t idx = dx - 1 ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else      
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -1781,9 +1785,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
       Index_t idx = dx*dy*(dz - 1) + (dx - 1) ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -1799,9 +1801,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
       Index_t idx = dx*(dy - 1) ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -1817,9 +1817,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
       Index_t idx = dx*dy*(dz - 1) + dx*(dy - 1) ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -1835,9 +1833,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
       Index_t idx = dx*dy - 1 ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -1853,9 +1849,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
       Index_t idx = dx*dy*dz - 1 ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -1869,7 +1863,7 @@ void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData)
 #if defined(USE_MPL_CXX)
 void CommSyncPosVel(Domain& domain, std::vector<mpl::irequest>&  rpool)
 #elif defined(USE_EMPI)
-void CommSyncPosVel(Domain& domain, std::vector<empi::async_event_p>&  rpool, std::unique_ptr<empi::MessageGroup>& comm_world)
+void CommSyncPosVel(Domain& domain, std::unique_ptr<lulesh_group>& comm_world)
 #else
 void CommSyncPosVel(Domain& domain) 
 #endif
@@ -1877,6 +1871,13 @@ void CommSyncPosVel(Domain& domain)
    if (domain.numRanks() == 1)
       return ;
 
+#if defined(USE_EMPI)
+   lulesh_trace::region region("CommSyncPosVel") ;
+   /* Complete the exchange on every rank, also on those that unpack from
+      fewer neighbors, before the next CommRecv/CommSend reuse its buffers */
+   comm_world->wait(halo.event) ;
+#endif
+
    int myRank ;
    bool doRecv = false ;
    Index_t xferFields = 6 ; /* x, y, z, xd, yd, zd */
@@ -1889,7 +1890,9 @@ void CommSyncPosVel(Domain& domain)
    Index_t dx = domain.sizeX() + 1 ;
    Index_t dy = domain.sizeY() + 1 ;
    Index_t dz = domain.sizeZ() + 1 ;
+#if !defined(USE_EMPI)
    MPI_Status status ;
+#endif
    Real_t *srcAddr ;
    bool rowMin, rowMax, colMin, colMax, planeMin, planeMax ;
 
@@ -1932,16 +1935,12 @@ void CommSyncPosVel(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<opCount; ++i) {
-               (domain.*dest)(i) = srcAddr[i] ;
-            }
+            CommUnpack(srcAddr, &(domain.*dest)(0), opCount, 1, 1) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -1951,16 +1950,12 @@ void CommSyncPosVel(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<opCount; ++i) {
-               (domain.*dest)(dx*dy*(dz - 1) + i) = srcAddr[i] ;
-            }
+            CommUnpack(srcAddr, &(domain.*dest)(dx*dy*(dz - 1)), opCount, 1, 1) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -1976,18 +1971,12 @@ void CommSyncPosVel(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dx; ++j) {
-                  (domain.*dest)(i*dx*dy + j) = srcAddr[i*dx + j] ;
-               }
-            }
+            CommUnpack(srcAddr, &(domain.*dest)(0), dz, dx, dx*dy) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -1997,18 +1986,12 @@ void CommSyncPosVel(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dx; ++j) {
-                  (domain.*dest)(dx*(dy - 1) + i*dx*dy + j) = srcAddr[i*dx + j] ;
-               }
-            }
+            CommUnpack(srcAddr, &(domain.*dest)(dx*(dy - 1)), dz, dx, dx*dy) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -2024,18 +2007,12 @@ void CommSyncPosVel(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dy; ++j) {
-                  (domain.*dest)(i*dx*dy + j*dx) = srcAddr[i*dy + j] ;
-               }
-            }
+            CommUnpack(srcAddr, &(domain.*dest)(0), dz*dy, 1, dx) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -2045,18 +2022,12 @@ void CommSyncPosVel(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
             Domain_member dest = fieldData[fi] ;
-            for (Index_t i=0; i<dz; ++i) {
-               for (Index_t j=0; j<dy; ++j) {
-                  (domain.*dest)(dx - 1 + i*dx*dy + j*dx) = srcAddr[i*dy + j] ;
-               }
-            }
+            CommUnpack(srcAddr, &(domain.*dest)(dx - 1), dz*dy, 1, dx) ;
             srcAddr += opCount ;
          }
          ++pmsg ;
@@ -2068,16 +2039,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dz; ++i) {
-            (domain.*dest)(i*dx*dy) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(0), dz, 1, dx*dy) ;
          srcAddr += dz ;
       }
       ++emsg ;
@@ -2088,16 +2055,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dx; ++i) {
-            (domain.*dest)(i) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(0), dx, 1, 1) ;
          srcAddr += dx ;
       }
       ++emsg ;
@@ -2108,16 +2071,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dy; ++i) {
-            (domain.*dest)(i*dx) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(0), dy, 1, dx) ;
          srcAddr += dy ;
       }
       ++emsg ;
@@ -2128,16 +2087,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dz; ++i) {
-            (domain.*dest)(dx*dy - 1 + i*dx*dy) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(dx*dy - 1), dz, 1, dx*dy) ;
          srcAddr += dz ;
       }
       ++emsg ;
@@ -2148,16 +2103,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dx; ++i) {
-            (domain.*dest)(dx*(dy-1) + dx*dy*(dz-1) + i) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(dx*(dy-1) + dx*dy*(dz-1)), dx, 1, 1) ;
          srcAddr += dx ;
       }
       ++emsg ;
@@ -2168,16 +2119,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dy; ++i) {
-            (domain.*dest)(dx*dy*(dz-1) + dx - 1 + i*dx) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(dx*dy*(dz-1) + dx - 1), dy, 1, dx) ;
          srcAddr += dy ;
       }
       ++emsg ;
@@ -2188,16 +2135,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dz; ++i) {
-            (domain.*dest)(dx*(dy-1) + i*dx*dy) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(dx*(dy-1)), dz, 1, dx*dy) ;
          srcAddr += dz ;
       }
       ++emsg ;
@@ -2208,16 +2151,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dx; ++i) {
-            (domain.*dest)(dx*dy*(dz-1) + i) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(dx*dy*(dz-1)), dx, 1, 1) ;
          srcAddr += dx ;
       }
       ++emsg ;
@@ -2228,16 +2167,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dy; ++i) {
-            (domain.*dest)(dx*dy*(dz-1) + i*dx) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(dx*dy*(dz-1)), dy, 1, dx) ;
          srcAddr += dy ;
       }
       ++emsg ;
@@ -2248,16 +2183,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dz; ++i) {
-            (domain.*dest)(dx - 1 + i*dx*dy) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(dx - 1), dz, 1, dx*dy) ;
          srcAddr += dz ;
       }
       ++emsg ;
@@ -2268,16 +2199,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dx; ++i) {
-            (domain.*dest)(dx*(dy - 1) + i) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(dx*(dy - 1)), dx, 1, 1) ;
          srcAddr += dx ;
       }
       ++emsg ;
@@ -2288,16 +2215,12 @@ void CommSyncPosVel(Domain& domain)
                                        emsg * maxEdgeComm] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg].wait();
-#elif defined(USE_EMPI)
-     rpool[pmsg+emsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg], &status) ;
 #endif
       for (Index_t fi=0 ; fi<xferFields; ++fi) {
          Domain_member dest = fieldData[fi] ;
-         for (Index_t i=0; i<dy; ++i) {
-            (domain.*dest)(dx - 1 + i*dx) = srcAddr[i] ;
-         }
+         CommUnpack(srcAddr, &(domain.*dest)(dx - 1), dy, 1, dx) ;
          srcAddr += dy ;
       }
       ++emsg ;
@@ -2311,9 +2234,7 @@ void CommSyncPosVel(Domain& domain)
                                       cmsg * CACHE_COHERENCE_PAD_REAL] ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else      
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -2329,9 +2250,7 @@ void CommSyncPosVel(Domain& domain)
       Index_t idx = dx*dy*(dz - 1) ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -2347,9 +2266,7 @@ void CommSyncPosVel(Domain& domain)
       Index_t idx = dx - 1 ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -2365,9 +2282,7 @@ void CommSyncPosVel(Domain& domain)
       Index_t idx = dx*dy*(dz - 1) + (dx - 1) ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -2383,9 +2298,7 @@ void CommSyncPosVel(Domain& domain)
       Index_t idx = dx*(dy - 1) ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -2401,9 +2314,7 @@ void CommSyncPosVel(Domain& domain)
       Index_t idx = dx*dy*(dz - 1) + dx*(dy - 1) ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -2419,9 +2330,7 @@ void CommSyncPosVel(Domain& domain)
       Index_t idx = dx*dy - 1 ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -2437,9 +2346,7 @@ void CommSyncPosVel(Domain& domain)
       Index_t idx = dx*dy*dz - 1 ;
 #if defined(USE_MPL_CXX)
       rpool[pmsg+emsg+cmsg].wait();
-#elif defined(USE_EMPI)
-      rpool[pmsg+emsg+cmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
       MPI_Wait(&domain.recvRequest[pmsg+emsg+cmsg], &status) ;
 #endif
       for (Index_t fi=0; fi<xferFields; ++fi) {
@@ -2453,7 +2360,7 @@ void CommSyncPosVel(Domain& domain)
 #if defined(USE_MPL_CXX)
 void CommMonoQ(Domain& domain, std::vector<mpl::irequest>&  rpool)
 #elif defined(USE_EMPI)
-void CommMonoQ(Domain& domain, std::vector<empi::async_event_p>&  rpool, std::unique_ptr<empi::MessageGroup>& comm_world)
+void CommMonoQ(Domain& domain, std::unique_ptr<lulesh_group>& comm_world)
 #else
 void CommMonoQ(Domain& domain)
 #endif
@@ -2461,6 +2368,13 @@ void CommMonoQ(Domain& domain)
    if (domain.numRanks() == 1)
       return ;
 
+#if defined(USE_EMPI)
+   lulesh_trace::region region("CommMonoQ") ;
+   /* Complete the exchange on every rank, also on those that unpack from
+      fewer neighbors, before the next CommRecv/CommSend reuse its buffers */
+   comm_world->wait(halo.event) ;
+#endif
+
    int myRank ;
    Index_t xferFields = 3 ; /* delv_xi, delv_eta, delv_zeta */
    Domain_member fieldData[3] ;
@@ -2470,7 +2384,9 @@ void CommMonoQ(Domain& domain)
    Index_t dx = domain.sizeX() ;
    Index_t dy = domain.sizeY() ;
    Index_t dz = domain.sizeZ() ;
+#if !defined(USE_EMPI)
    MPI_Status status ;
+#endif
    Real_t *srcAddr ;
    bool rowMin, rowMax, colMin, colMax, planeMin, planeMax ;
    /* assume communication to 6 neighbors by default */
@@ -2516,9 +2432,7 @@ void CommMonoQ(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
@@ -2536,9 +2450,7 @@ void CommMonoQ(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
@@ -2562,9 +2474,7 @@ void CommMonoQ(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
@@ -2582,9 +2492,7 @@ void CommMonoQ(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else         
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
@@ -2607,9 +2515,7 @@ void CommMonoQ(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
@@ -2627,9 +2533,7 @@ void CommMonoQ(Domain& domain)
          srcAddr = &domain.commDataRecv[pmsg * maxPlaneComm] ;
 #if defined(USE_MPL_CXX)
          rpool[pmsg].wait();
-#elif defined(USE_EMPI)
-         rpool[pmsg]->wait<empi::details::no_status>();
-#else 
+#elif !defined(USE_EMPI)
          MPI_Wait(&domain.recvRequest[pmsg], &status) ;
 #endif
          for (Index_t fi=0 ; fi<xferFields; ++fi) {
@@ -1105,7 +1105,7 @@ void CalcVolumeForceForElems(Domain& domain)
 /******************************************/
 
 #if defined (USE_EMPI)
-static inline void CalcForceForNodes(Domain& domain, std::unique_ptr<empi::MessageGroup>& comm_world)
+static inline void CalcForceForNodes(Domain& domain, std::unique_ptr<lulesh_group>& comm_world)
 #else
 static inline void CalcForceForNodes(Domain& domain)
 #endif
@@ -1115,8 +1115,6 @@ static inline void CalcForceForNodes(Domain& domain)
 #if defined(USE_MPI) && USE_MPI == 1
    #if defined(USE_MPL_CXX)
       std::vector<mpl::irequest>  rpool;
-   #elif defined(USE_EMPI)
-      std::vector<empi::async_event_p> rpool;
    #endif
 #endif 
 
@@ -1126,10 +1124,6 @@ static inline void CalcForceForNodes(Domain& domain)
   CommRecv(domain, MSG_COMM_SBN, 3,
            domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
            true, false, rpool) ;
-#elif defined(USE_EMPI)
-  CommRecv(domain, MSG_COMM_SBN, 3,
-           domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
-           true, false, rpool, comm_world) ;
 #else
   CommRecv(domain, MSG_COMM_SBN, 3,
            domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
@@ -1159,7 +1153,7 @@ static inline void CalcForceForNodes(Domain& domain)
 #if defined(USE_MPL_CXX)
   CommSBN(domain, 3, fieldData, rpool) ;
 #elif defined(USE_EMPI)
-  CommSBN(domain, 3, fieldData, rpool, comm_world) ;
+  CommSBN(domain, 3, fieldData, comm_world) ;
 #else
   CommSBN(domain, 3, fieldData) ;
 #endif  
@@ -1252,7 +1246,7 @@ void CalcPositionForNodes(Domain &domain, const Real_t dt, Index_t numNode)
 
 /******************************************/
 #if defined (USE_EMPI)
-   static inline void LagrangeNodal(Domain& domain, std::unique_ptr<empi::MessageGroup>& comm_world)
+   static inline void LagrangeNodal(Domain& domain, std::unique_ptr<lulesh_group>& comm_world)
 #else
    static inline void LagrangeNodal(Domain& domain)
 #endif
@@ -1271,8 +1265,6 @@ void CalcPositionForNodes(Domain &domain, const Real_t dt, Index_t numNode)
 #if defined(USE_MPI) && USE_MPI == 1
 #if defined(USE_MPL_CXX)
   std::vector<mpl::irequest>  rpool;
-#elif defined(USE_EMPI)
-  std::vector<empi::async_event_p> rpool;
 #endif
 #endif  
 
@@ -1282,10 +1274,6 @@ void CalcPositionForNodes(Domain &domain, const Real_t dt, Index_t numNode)
    CommRecv(domain, MSG_SYNC_POS_VEL, 6,
             domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
             false, false, rpool) ;
-#elif defined(USE_EMPI)
-   CommRecv(domain, MSG_SYNC_POS_VEL, 6,
-            domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
-            false, false, rpool, comm_world) ;
 #else
    CommRecv(domain, MSG_SYNC_POS_VEL, 6,
             domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
@@ -1322,7 +1310,7 @@ void CalcPositionForNodes(Domain &domain, const Real_t dt, Index_t numNode)
 #if defined(USE_MPL_CXX)
    CommSyncPosVel(domain, rpool) ;
 #elif defined(USE_EMPI)
-   CommSyncPosVel(domain, rpool, comm_world) ;
+   CommSyncPosVel(domain, comm_world) ;
 #else
    CommSyncPosVel(domain) ;
 #endif
@@ -2006,7 +1994,7 @@ void CalcMonotonicQForElems(Domain& domain)
 
 /******************************************/
 #if defined (USE_EMPI)
-static inline void CalcQForElems(Domain& domain, std::unique_ptr<empi::MessageGroup>& comm_world)
+static inline void CalcQForElems(Domain& domain, std::unique_ptr<lulesh_group>& comm_world)
 #else
 static inline void CalcQForElems(Domain& domain)
 #endif
@@ -2027,8 +2015,6 @@ static inline void CalcQForElems(Domain& domain)
 #if defined(USE_MPI) && USE_MPI == 1
 #if defined(USE_MPL_CXX)
   std::vector<mpl::irequest>  rpool;
-#elif defined(USE_EMPI)
-  std::vector<empi::async_event_p> rpool;
 #endif
 #endif 
 
@@ -2037,10 +2023,6 @@ static inline void CalcQForElems(Domain& domain)
       CommRecv(domain, MSG_MONOQ, 3,
                domain.sizeX(), domain.sizeY(), domain.sizeZ(),
                true, true, rpool) ;
-#elif defined(USE_EMPI)
-      CommRecv(domain, MSG_MONOQ, 3,
-               domain.sizeX(), domain.sizeY(), domain.sizeZ(),
-               true, true, rpool, comm_world) ;
 #else
       CommRecv(domain, MSG_MONOQ, 3,
                domain.sizeX(), domain.sizeY(), domain.sizeZ(),
@@ -2074,7 +2056,7 @@ static inline void CalcQForElems(Domain& domain)
 #if defined(USE_MPL_CXX)
       CommMonoQ(domain, rpool);
 #elif defined(USE_EMPI)
-      CommMonoQ(domain, rpool, comm_world) ;
+      CommMonoQ(domain, comm_world) ;
 #else
       CommMonoQ(domain) ;
 #endif      
@@ -2524,7 +2506,7 @@ void UpdateVolumesForElems(Domain &domain,
 /******************************************/
 
 #if defined (USE_EMPI)
-static inline void LagrangeElements(Domain& domain, Index_t numElem, std::unique_ptr<empi::MessageGroup>& comm_world)
+static inline void LagrangeElements(Domain& domain, Index_t numElem, std::unique_ptr<lulesh_group>& comm_world)
 #else
 static inline void LagrangeElements(Domain& domain, Index_t numElem)
 #endif
@@ -2696,7 +2678,7 @@ void CalcTimeConstraintsForElems(Domain& domain) {
 /******************************************/
 
 #if defined (USE_EMPI)
-static inline void LagrangeLeapFrog(Domain& domain, std::unique_ptr<empi::MessageGroup>& comm_world)
+static inline void LagrangeLeapFrog(Domain& domain, std::unique_ptr<lulesh_group>& comm_world)
 #else
 static inline void LagrangeLeapFrog(Domain& domain)
 #endif
@@ -2719,8 +2701,6 @@ static inline void LagrangeLeapFrog(Domain& domain)
 #if defined(USE_MPI) && USE_MPI == 1
 #if defined(USE_MPL_CXX)
   std::vector<mpl::irequest>  rpool;
-#elif defined(USE_EMPI)
-  std::vector<empi::async_event_p> rpool;
 #endif
 #endif
 
@@ -2731,10 +2711,6 @@ static inline void LagrangeLeapFrog(Domain& domain)
    CommRecv(domain, MSG_SYNC_POS_VEL, 6,
             domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
             false, false, rpool) ;
-#elif defined(USE_EMPI)
-   CommRecv(domain, MSG_SYNC_POS_VEL, 6,
-            domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
-            false, false, rpool) ;
 #else
    CommRecv(domain, MSG_SYNC_POS_VEL, 6,
             domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
@@ -2748,10 +2724,16 @@ static inline void LagrangeLeapFrog(Domain& domain)
    fieldData[4] = &Domain::yd ;
    fieldData[5] = &Domain::zd ;
    
+#if defined(USE_EMPI)
+   CommSend(domain, MSG_SYNC_POS_VEL, 6, fieldData,
+            domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
+            false, false, comm_world) ;
+#else
    CommSend(domain, MSG_SYNC_POS_VEL, 6, fieldData,
             domain.sizeX() + 1, domain.sizeY() + 1, domain.sizeZ() + 1,
             false, false) ;
 #endif
+#endif
 #endif   
 
    CalcTimeConstraintsForElems(domain);
@@ -2761,7 +2743,7 @@ static inline void LagrangeLeapFrog(Domain& domain)
 #if defined(USE_MPL_CXX)
    CommSyncPosVel(domain, rpool) ;
 #elif defined(USE_EMPI)
-   CommSyncPosVel(domain, rpool) ;
+   CommSyncPosVel(domain, comm_world) ;
 #else
    CommSyncPosVel(domain) ;
 #endif
@@ -2777,7 +2759,7 @@ static inline void LagrangeLeapFrog(Domain& domain)
 /******************************************/
 // Declare comm_world
 #ifdef USE_EMPI
-std::unique_ptr<empi::MessageGroup> comm_world = nullptr;
+std::unique_ptr<lulesh_group> comm_world = nullptr;
 #endif
 
 int main(int argc, char *argv[])
@@ -2797,7 +2779,7 @@ int main(int argc, char *argv[])
    const mpl::communicator &comm_world(mpl::environment::comm_world());
 #elif defined(USE_EMPI)
    static empi::Context ctx{&argc,&argv};
-   auto comm_world = ctx.create_message_group(MPI_COMM_WORLD);
+   auto comm_world = ctx.create_message_group<lulesh_trace>(MPI_COMM_WORLD);
    
 #else
    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &thread_support);
@@ -2813,7 +2795,7 @@ int main(int argc, char *argv[])
    const mpl::communicator &comm_world(mpl::environment::comm_world());
 #elif defined(USE_EMPI)
    empi::Context ctx{&argc,&argv};
-   auto comm_world = ctx.create_message_group(MPI_COMM_WORLD);
+   auto comm_world = ctx.create_message_group<lulesh_trace>(MPI_COMM_WORLD);
 #else
    MPI_Init(&argc, &argv);
 #endif
@@ -2874,11 +2856,17 @@ int main(int argc, char *argv[])
 #if USE_MPI   
    fieldData = &Domain::nodalMass ;
 
+#if defined(USE_EMPI)
+   // Halo exchanges run as neighborhood collectives over the adjacent domains
+   {
+      std::vector<int> neighbors = CommNeighbors(*locDom) ;
+      comm_world = ctx.create_graph_group<lulesh_trace>(MPI_COMM_WORLD, neighbors, neighbors) ;
+   }
+#endif
+
 #if defined(USE_MPI) && USE_MPI == 1
 #if defined(USE_MPL_CXX)
   std::vector<mpl::irequest>  rpool;
-#elif defined(USE_EMPI)
-  std::vector<empi::async_event_p> rpool;
 #endif
 #endif 
 
@@ -2887,10 +2875,6 @@ int main(int argc, char *argv[])
    CommRecv(*locDom, MSG_COMM_SBN, 1,
             locDom->sizeX() + 1, locDom->sizeY() + 1, locDom->sizeZ() + 1,
             true, false, rpool);
-#elif defined(USE_EMPI)
-   CommRecv(*locDom, MSG_COMM_SBN, 1,
-            locDom->sizeX() + 1, locDom->sizeY() + 1, locDom->sizeZ() + 1,
-            true, false, rpool, comm_world) ;
 #else
    CommRecv(*locDom, MSG_COMM_SBN, 1,
             locDom->sizeX() + 1, locDom->sizeY() + 1, locDom->sizeZ() + 1,
@@ -2908,7 +2892,7 @@ int main(int argc, char *argv[])
 #if defined(USE_MPL_CXX)
    CommSBN(*locDom, 1, &fieldData, rpool) ;
 #elif defined(USE_EMPI)
-   CommSBN(*locDom, 1, &fieldData, rpool, comm_world) ;
+   CommSBN(*locDom, 1, &fieldData, comm_world) ;
 #else
    CommSBN(*locDom, 1, &fieldData) ;
 #endif
@@ -14,6 +14,17 @@
 
 #include <empi/empi.hpp>
 
+/* With USE_EMPI_TRACE every EMPI call of LULESH, halo waits included, is
+   recorded and written at exit to empi_trace.json, a Chrome trace with one
+   track per rank (see empi/trace.hpp). The calls of each exchange are
+   enclosed in regions named after it, e.g. CommSBN.send and CommSBN. */
+#if defined(USE_EMPI_TRACE)
+typedef empi::recording_trace lulesh_trace ;
+#else
+typedef empi::no_trace lulesh_trace ;
+#endif
+typedef empi::BasicMessageGroup<lulesh_trace> lulesh_group ;
+
 // struct comm_world_s{
 
 //       static void init(empi::Context& ctx){
@@ -668,14 +679,15 @@ void CommSend(Domain& domain, Int_t msgType,
 #elif defined(USE_EMPI)
 void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
               Index_t dx, Index_t dy, Index_t dz,
-              bool doRecv, bool planeOnly, std::vector<empi::async_event_p>& rpool, std::unique_ptr<empi::MessageGroup>& comm_world);
-void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData, std::vector<empi::async_event_p>& rpool, std::unique_ptr<empi::MessageGroup>& comm_world);
-void CommSyncPosVel(Domain& domain, std::vector<empi::async_event_p>& rpool, std::unique_ptr<empi::MessageGroup>& comm_world);
-void CommMonoQ(Domain& domain, std::vector<empi::async_event_p>& rpool, std::unique_ptr<empi::MessageGroup>& comm_world);
+              bool doRecv, bool planeOnly);
+void CommSBN(Domain& domain, Int_t xferFields, Domain_member *fieldData, std::unique_ptr<lulesh_group>& comm_world);
+void CommSyncPosVel(Domain& domain, std::unique_ptr<lulesh_group>& comm_world);
+void CommMonoQ(Domain& domain, std::unique_ptr<lulesh_group>& comm_world);
 void CommSend(Domain& domain, Int_t msgType,
               Index_t xferFields, Domain_member *fieldData,
               Index_t dx, Index_t dy, Index_t dz,
-              bool doSend, bool planeOnly, std::unique_ptr<empi::MessageGroup>& comm_world);
+              bool doSend, bool planeOnly, std::unique_ptr<lulesh_group>& comm_world);
+std::vector<int> CommNeighbors(Domain& domain);
 #else
 void CommRecv(Domain& domain, Int_t msgType, Index_t xferFields,
               Index_t dx, Index_t dy, Index_t dz,
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Allreduce with stateless lambdas as reductions. A min-with-location lambda
+// over {double, int} pairs is checked against MPI_MINLOC on MPI_DOUBLE_INT and
+// then timed. A non commutative one (decimal concatenation of the ranks) is
+// checked to combine the contributions in rank order.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <mpi.h>
+#include <vector>
+
+using namespace std;
+
+// Same layout as MPI_DOUBLE_INT
+struct value_index {
+    double value;
+    int index;
+};
+
+// The digits of value, scale is 10^(number of digits)
+struct digits {
+    long value;
+    long scale;
+};
+
+int main(int argc, char **argv) {
+    int n, max_iter, pow_2;
+    double t_start = 0.0, t_end;
+    constexpr int SCALE = 1000000;
+    empi::Context ctx(&argc, &argv);
+
+    // ------ PARAMETER SETUP -----------
+    pow_2 = static_cast<int>(strtol(argv[1], nullptr, 10));
+    max_iter = static_cast<int>(strtol(argv[2], nullptr, 10));
+    double mpi_time = 0.0;
+    n = static_cast<int>(std::pow(2, pow_2));
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    const int rank = message_group->rank();
+    const int size = message_group->size();
+
+    // Several ranks hold the minimum of each element, the lowest index must win
+    std::vector<value_index> myarr(n), dest(n), expected(n);
+    for(int i = 0; i < n; i++) myarr[i] = {static_cast<double>((i + rank) % 3), rank};
+    MPI_Allreduce(myarr.data(), expected.data(), n, MPI_DOUBLE_INT, MPI_MINLOC, MPI_COMM_WORLD);
+
+    const auto minloc = [](const value_index &a, const value_index &b) {
+        return a.value < b.value || (a.value == b.value && a.index < b.index) ? a : b;
+    };
+
+    message_group->run([&](empi::MessageGroupHandler<value_index, empi::Tag{0}, empi::NOSIZE> &mgh) {
+        // Warmup
+        mgh.barrier();
+        mgh.Allreduce(myarr.data(), dest.data(), n, minloc);
+        for(int i = 0; i < n; i++) {
+            if(dest[i].value != expected[i].value || dest[i].index != expected[i].index) {
+                cerr << "rank " << rank << ": element " << i << " differs from MPI_MINLOC\n";
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            }
+        }
+        mgh.barrier();
+
+        // main measurement
+        if(rank == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) { mgh.Allreduce(myarr.data(), dest.data(), n, minloc); }
+
+        mgh.barrier();
+        if(rank == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    message_group->run([&](empi::MessageGroupHandler<digits, empi::Tag{1}, empi::NOSIZE> &mgh) {
+        digits mine{rank % 10, 10}, all{0, 1}, expected_digits{0, 1};
+        for(int r = 0; r < size; r++) expected_digits = {expected_digits.value * 10 + r % 10, expected_digits.scale * 10};
+        mgh.Allreduce(&mine, &all, 1, empi::non_commutative([](const digits &a, const digits &b) {
+            return digits{a.value * b.scale + b.value, a.scale * b.scale};
+        }));
+        if(all.value != expected_digits.value || all.scale != expected_digits.scale) {
+            cerr << "rank " << rank << ": non commutative reduction out of rank order (" << all.value << ")\n";
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    });
+
+    message_group->barrier();
+
+    if(rank == 0) { cout << mpi_time << "\n"; }
+    return 0;
+} // end main
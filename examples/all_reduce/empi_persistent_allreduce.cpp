@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Allreduce on a persistent collective: the schedule is built once by
+// Allreduce_init and every iteration only restarts it.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <mpi.h>
+
+using namespace std;
+using value_type = int;
+
+int main(int argc, char **argv) {
+    int n, max_iter, pow_2;
+    double t_start, t_end;
+    constexpr int SCALE = 1000000;
+    empi::Context ctx(&argc, &argv);
+
+    // ------ PARAMETER SETUP -----------
+    pow_2 = static_cast<int>(strtol(argv[1], nullptr, 10));
+    max_iter = static_cast<int>(strtol(argv[2], nullptr, 10));
+    double mpi_time = 0.0;
+    n = static_cast<int>(std::pow(2, pow_2));
+
+    std::vector<value_type> myarr(n, 0);
+    std::vector<value_type> dest(n, 0);
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+
+    message_group->run([&](empi::MessageGroupHandler<value_type, empi::Tag{0}, empi::NOSIZE> &mgh) {
+        auto allreduce = mgh.Allreduce_init(myarr.data(), dest.data(), n, MPI_SUM);
+
+        // Warmup
+        mgh.barrier();
+        allreduce();
+        mgh.barrier();
+
+        // main measurement
+        if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) { allreduce(); }
+
+        mgh.barrier();
+        if(message_group->rank() == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) { cout << mpi_time << "\n"; }
+    return 0;
+} // end main
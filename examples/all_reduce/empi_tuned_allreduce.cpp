@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <unistd.h>
+
+using namespace std;
+using value_type = int;
+
+int main(int argc, char **argv) {
+    int myid, n, max_iter, pow_2;
+    double t_start, t_end, t_start_inner;
+    constexpr int SCALE = 1000000;
+    constexpr int warmup = 16;
+    // Tuning table at argv[3] if given, the sizes it misses are tuned online during the warmup
+    empi::Context ctx(&argc, &argv, {argc > 3 ? argv[3] : "", true});
+
+    // ------ PARAMETER SETUP -----------
+    pow_2 = static_cast<int>(strtol(argv[1], nullptr, 10));
+    max_iter = static_cast<int>(strtol(argv[2], nullptr, 10));
+    double mpi_time = 0.0;
+    n = static_cast<int>(std::pow(2, pow_2));
+
+    std::vector<value_type> myarr(n, 0);
+    std::vector<value_type> dest(n, 0);
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    MPI_Status status;
+
+    message_group->run([&](empi::MessageGroupHandler<value_type, empi::Tag{0}, empi::NOSIZE> &mgh) {
+        // Warmup, long enough to try every candidate algorithm
+        mgh.barrier();
+        for(auto iter = 0; iter < warmup; iter++) mgh.Allreduce(myarr.data(), dest.data(), n, MPI_SUM);
+        mgh.barrier();
+
+        // main measurement
+        if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) { mgh.Allreduce(myarr.data(), dest.data(), n, MPI_SUM); }
+
+        mgh.barrier();
+        if(message_group->rank() == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) {
+        cout << mpi_time << "\n";
+    }
+    return 0;
+} // end main
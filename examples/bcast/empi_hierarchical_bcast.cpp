@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <unistd.h>
+
+using namespace std;
+
+int main(int argc, char **argv) {
+    int myid, procs, err, max_iter, nBytes, sleep_time, range = 100, pow_2;
+    long n;
+    double t_start, t_end, t_start_inner, mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+
+    empi::Context ctx(&argc, &argv);
+
+    // ------ PARAMETER SETUP -----------
+    pow_2 = atoi(argv[1]);
+    max_iter = atoi(argv[2]);
+
+    nBytes = std::pow(2, pow_2);
+    n = nBytes;
+    std::vector<char> myarr(n, 0);
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    // Node-aware bcast, flat above argv[3] bytes when given
+    auto table = empi::threshold_table::all(empi::collective_mode::hierarchical);
+    if(argc > 3)
+        table.bcast = {{strtoul(argv[3], nullptr, 10), empi::collective_mode::hierarchical},
+            {SIZE_MAX, empi::collective_mode::flat}};
+    message_group->set_collective_table(table);
+    MPI_Status status;
+
+    message_group->run([&](empi::MessageGroupHandler<char, empi::Tag{0}, empi::NOSIZE> &mgh) {
+        // Warmup
+        message_group->barrier();
+        mgh.Bcast(myarr.data(), 0, n);
+        message_group->barrier();
+
+        // main measurement
+        if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) { mgh.Bcast(myarr.data(), 0, n); }
+
+        message_group->barrier();
+        if(message_group->rank() == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) {
+        cout << mpi_time << "\n";
+    }
+    return 0;
+} // end main
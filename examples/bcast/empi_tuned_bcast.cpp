@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+
+int main(int argc, char **argv) {
+    int myid, procs, err, max_iter, nBytes, sleep_time, range = 100, pow_2;
+    long n;
+    double t_start, t_end, t_start_inner, mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+    constexpr int warmup = 16;
+
+    // Tuning table at argv[3] if given, the sizes it misses are tuned online during the warmup
+    empi::Context ctx(&argc, &argv, {argc > 3 ? argv[3] : "", true});
+
+    // ------ PARAMETER SETUP -----------
+    pow_2 = atoi(argv[1]);
+    max_iter = atoi(argv[2]);
+
+    nBytes = std::pow(2, pow_2);
+    n = nBytes;
+    std::vector<char> myarr(n, 0);
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    MPI_Status status;
+
+    message_group->run([&](empi::MessageGroupHandler<char, empi::Tag{0}, empi::NOSIZE> &mgh) {
+        // Warmup, long enough to try every candidate algorithm
+        message_group->barrier();
+        for(auto iter = 0; iter < warmup; iter++) mgh.Bcast(myarr.data(), 0, n);
+        message_group->barrier();
+
+        // main measurement
+        if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) { mgh.Bcast(myarr.data(), 0, n); }
+
+        message_group->barrier();
+        if(message_group->rank() == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) {
+        cout << mpi_time << "\n";
+    }
+    return 0;
+} // end main
@@ -44,7 +44,7 @@ int main(int argc, char **argv) {
     const volatile auto next = message_group->next();
 
     message_group->run([&](empi::MessageGroupHandler<char, empi::Tag{0}, empi::NOSIZE> &mgh) {
-        std::array<empi::async_event_p, 4> events;
+        std::array<empi::async_event, 4> events;
 
         mgh.Irecv(arr, prev, n);
         mgh.Irecv(arr, next, n);
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Bidirectional ring on persistent channels: the four requests are created
+// once with MPI_Send_init/MPI_Recv_init and re-armed by MPI_Startall.
+
+#include <cmath>
+#include <cstdio>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <mpi.h>
+
+using namespace std;
+using value_type = char;
+
+int main(int argc, char **argv) {
+    double t_start, t_end;
+    double mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+    long pow_2_bytes;
+    int n;
+    long max_iter;
+
+    pow_2_bytes = strtol(argv[1], nullptr, 10);
+    n = static_cast<int>(std::pow(2, pow_2_bytes));
+    max_iter = strtol(argv[2], nullptr, 10);
+
+    std::vector<value_type> arr(n, 0);
+    auto ctx = empi::Context(&argc, &argv);
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+
+    const auto prev = message_group->prec();
+    const auto next = message_group->next();
+
+    message_group->run([&](empi::MessageGroupHandler<char, empi::Tag{0}, empi::NOSIZE> &mgh) {
+        empi::channel_set channels;
+        channels.add(mgh.persistent_recv(arr, prev, n))
+            .add(mgh.persistent_recv(arr, next, n))
+            .add(mgh.persistent_send(arr, prev, n))
+            .add(mgh.persistent_send(arr, next, n));
+
+        // Warmup
+        channels.startall();
+        channels.waitall();
+        message_group->barrier();
+
+        if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) {
+            channels.startall();
+            channels.waitall();
+        }
+
+        message_group->barrier();
+        if(message_group->rank() == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) { cout << mpi_time << "\n"; }
+    return 0;
+} // end main
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <ranges>
+#include <unistd.h>
+
+using namespace std;
+using value_type = char;
+
+int main(int argc, char **argv) {
+    double t_start, t_end;
+    double mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+    long pow_2_bytes;
+    int n;
+    long max_iter;
+
+    pow_2_bytes = strtol(argv[1], nullptr, 10);
+    n = static_cast<int>(std::pow(2, pow_2_bytes));
+    max_iter = strtol(argv[2], nullptr, 10);
+
+    std::vector<value_type> arr(n, 0);
+    auto ctx = empi::Context(&argc, &argv);
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+
+    const volatile auto prev = message_group->prec();
+    const volatile auto next = message_group->next();
+
+    // Every neighbor on this node copies arr straight from its shared segment
+    // into its ghost buffers: the same n bytes per neighbor as the MPI variants
+    auto ring = message_group->shared_buffer<value_type>(n);
+    std::copy(arr.begin(), arr.end(), ring.local().begin());
+    const std::vector<int> peers{prev, next};
+    std::vector<value_type> from_prev(n), from_next(n);
+    auto exchange = [&] {
+        ring.post(peers);
+        std::copy_n(ring.get(prev), n, from_prev.begin());
+        std::copy_n(ring.get(next), n, from_next.begin());
+        ring.release();
+    };
+
+    // Warmup
+    exchange();
+    message_group->barrier();
+
+    if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+    for(auto iter = 0; iter < max_iter; iter++) exchange();
+
+    message_group->barrier();
+    if(message_group->rank() == 0) {
+        t_end = MPI_Wtime();
+        mpi_time = (t_end - t_start) * SCALE;
+    }
+    arr[0] = from_prev[n - 1] + from_next[0];
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) {
+        // cout << "\nData Size: " << nBytes << " bytes\n";
+        cout << mpi_time << "\n";
+        // cout << "Mean of communication times: " << Mean(mpi_time, num_restart)
+        //      << "\n";
+        // cout << "Median of communication times: " << Median(mpi_time, num_restart)
+        //      << "\n";
+        // 	Print_times(mpi_time, num_restart);
+    }
+    return 0;
+} // end main
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Halo exchange over a periodic 3D cartesian grid of blocks: along every
+// dimension the high face goes up and the low face goes down, to the peers
+// given by shift(). Faces are sent in place through a strided view and
+// received into contiguous ghost planes, which are checked after the warm up.
+// arg1: log2 of the block edge, arg2: number of iterations
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <mpi.h>
+#include <vector>
+
+using namespace std;
+using value_type = double;
+
+int main(int argc, char **argv) {
+    double t_start = 0.0, t_end;
+    double mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+    long pow_2_edge;
+    int n;
+    long max_iter;
+
+    pow_2_edge = strtol(argv[1], nullptr, 10);
+    n = static_cast<int>(std::pow(2, pow_2_edge));
+    max_iter = strtol(argv[2], nullptr, 10);
+
+    auto ctx = empi::Context(&argc, &argv);
+    auto grid = ctx.create_cartesian_group({0, 0, 0}, {1, 1, 1});
+    const int rank = grid->rank();
+
+    std::vector<value_type> block(n * n * n, rank);
+    // ghosts[d][0] comes from below along d, ghosts[d][1] from above
+    std::array<std::array<std::vector<value_type>, 2>, 3> ghosts;
+    std::array<empi::cart_shift, 3> peers;
+    for(int d = 0; d < 3; d++) {
+        ghosts[d][0].assign(n * n, -1);
+        ghosts[d][1].assign(n * n, -1);
+        peers[d] = grid->shift(d, 1);
+    }
+
+    const std::array<int, 3> sizes{n, n, n};
+    auto face = [&](int d, int index) {
+        std::array<int, 3> extent{n, n, n}, origin{0, 0, 0};
+        extent[d] = 1;
+        origin[d] = index;
+        return empi::subarray(block.data(), sizes, extent, origin);
+    };
+
+    auto exchange = [&](empi::MessageGroupHandler<value_type, empi::NOTAG, empi::NOSIZE> &mgh) {
+        for(int d = 0; d < 3; d++) {
+            mgh.Irecv(ghosts[d][0], peers[d].source, n * n, empi::Tag{2 * d});
+            mgh.Irecv(ghosts[d][1], peers[d].dest, n * n, empi::Tag{2 * d + 1});
+        }
+        for(int d = 0; d < 3; d++) {
+            mgh.Isend(face(d, n - 1), peers[d].dest, empi::Tag{2 * d});
+            mgh.Isend(face(d, 0), peers[d].source, empi::Tag{2 * d + 1});
+        }
+        mgh.waitall();
+    };
+
+    grid->run([&](empi::MessageGroupHandler<value_type, empi::NOTAG, empi::NOSIZE> &mgh) {
+        // Warmup
+        exchange(mgh);
+        for(int d = 0; d < 3; d++) {
+            for(int side = 0; side < 2; side++) {
+                const int from = side == 0 ? peers[d].source : peers[d].dest;
+                for(auto v : ghosts[d][side]) {
+                    if(v != from) {
+                        cerr << "rank " << rank << ": wrong ghost plane from " << from << " along " << d << "\n";
+                        MPI_Abort(MPI_COMM_WORLD, 1);
+                    }
+                }
+            }
+        }
+        grid->barrier();
+
+        if(rank == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) exchange(mgh);
+
+        grid->barrier();
+        if(rank == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    grid->barrier();
+
+    if(rank == 0) { cout << mpi_time << "\n"; }
+    return 0;
+} // end main
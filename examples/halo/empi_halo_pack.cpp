@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Halo exchange of the three minimum faces of an edge^3 block, for xferFields
+// separate field arrays. Faces are packed into a staging buffer with the same
+// loops as CommSend in LULESH (lulesh-comm.cc) and unpacked on arrival.
+// arg1: log2 of the block edge, arg2: number of iterations
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using value_type = double;
+
+int main(int argc, char **argv) {
+    double t_start, t_end;
+    double mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+    constexpr int xferFields = 3;
+    long pow_2_edge;
+    int n;
+    long max_iter;
+
+    pow_2_edge = strtol(argv[1], nullptr, 10);
+    n = static_cast<int>(std::pow(2, pow_2_edge));
+    max_iter = strtol(argv[2], nullptr, 10);
+
+    const int dx = n, dy = n, dz = n;
+    const int faceSize = n * n;
+    std::vector<std::vector<value_type>> fields(xferFields, std::vector<value_type>(n * n * n, 1.0));
+    std::vector<std::vector<value_type>> ghosts(xferFields, std::vector<value_type>(n * n * n, 0.0));
+    std::vector<value_type> commDataSend(3 * xferFields * faceSize);
+    std::vector<value_type> commDataRecv(3 * xferFields * faceSize);
+
+    auto ctx = empi::Context(&argc, &argv);
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    const auto prev = message_group->prec();
+    const auto next = message_group->next();
+
+    auto exchange = [&](empi::MessageGroupHandler<value_type, empi::NOTAG, empi::NOSIZE> &mgh) {
+        for(int face = 0; face < 3; face++)
+            mgh.Irecv(&commDataRecv[face * xferFields * faceSize], prev, xferFields * faceSize, empi::Tag{face});
+
+        // plane
+        value_type *destAddr = &commDataSend[0];
+        for(int fi = 0; fi < xferFields; ++fi) {
+            const value_type *src = fields[fi].data();
+            for(int i = 0; i < dx * dy; ++i) destAddr[i] = src[i];
+            destAddr += faceSize;
+        }
+        // row
+        for(int fi = 0; fi < xferFields; ++fi) {
+            const value_type *src = fields[fi].data();
+            for(int i = 0; i < dz; ++i)
+                for(int j = 0; j < dx; ++j) destAddr[i * dx + j] = src[i * dx * dy + j];
+            destAddr += faceSize;
+        }
+        // col
+        for(int fi = 0; fi < xferFields; ++fi) {
+            const value_type *src = fields[fi].data();
+            for(int i = 0; i < dz; ++i)
+                for(int j = 0; j < dy; ++j) destAddr[i * dy + j] = src[i * dx * dy + j * dx];
+            destAddr += faceSize;
+        }
+        for(int face = 0; face < 3; face++)
+            mgh.Isend(&commDataSend[face * xferFields * faceSize], next, xferFields * faceSize, empi::Tag{face});
+
+        mgh.waitall();
+
+        const value_type *srcAddr = &commDataRecv[0];
+        for(int fi = 0; fi < xferFields; ++fi) {
+            value_type *dest = ghosts[fi].data();
+            for(int i = 0; i < dx * dy; ++i) dest[i] = srcAddr[i];
+            srcAddr += faceSize;
+        }
+        for(int fi = 0; fi < xferFields; ++fi) {
+            value_type *dest = ghosts[fi].data();
+            for(int i = 0; i < dz; ++i)
+                for(int j = 0; j < dx; ++j) dest[i * dx * dy + j] = srcAddr[i * dx + j];
+            srcAddr += faceSize;
+        }
+        for(int fi = 0; fi < xferFields; ++fi) {
+            value_type *dest = ghosts[fi].data();
+            for(int i = 0; i < dz; ++i)
+                for(int j = 0; j < dy; ++j) dest[i * dx * dy + j * dx] = srcAddr[i * dy + j];
+            srcAddr += faceSize;
+        }
+    };
+
+    message_group->run([&](empi::MessageGroupHandler<value_type, empi::NOTAG, empi::NOSIZE> &mgh) {
+        // Warmup
+        exchange(mgh);
+        message_group->barrier();
+
+        if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) exchange(mgh);
+
+        message_group->barrier();
+        if(message_group->rank() == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) { cout << mpi_time << "\n"; }
+    return 0;
+} // end main
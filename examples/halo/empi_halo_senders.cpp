@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Halo exchange of the three minimum faces of an edge^3 block, for xferFields
+// separate field arrays. Faces are packed into a staging buffer with the same
+// loops as CommSend in LULESH (lulesh-comm.cc). The exchange is a sender
+// pipeline per face: pack on a thread pool -> Isend, Irecv -> unpack, so the
+// packing overlaps the receives and each face is unpacked as soon as it arrives.
+// arg1: log2 of the block edge, arg2: number of iterations, arg3: packing threads (default 2)
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+namespace ex = empi::execution;
+using value_type = double;
+
+int main(int argc, char **argv) {
+    double t_start, t_end;
+    double mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+    constexpr int xferFields = 3;
+    long pow_2_edge;
+    int n;
+    long max_iter;
+
+    pow_2_edge = strtol(argv[1], nullptr, 10);
+    n = static_cast<int>(std::pow(2, pow_2_edge));
+    max_iter = strtol(argv[2], nullptr, 10);
+    const unsigned threads = argc > 3 ? strtoul(argv[3], nullptr, 10) : 2;
+
+    const int dx = n, dy = n, dz = n;
+    const int faceSize = n * n;
+    std::vector<std::vector<value_type>> fields(xferFields, std::vector<value_type>(n * n * n, 1.0));
+    std::vector<std::vector<value_type>> ghosts(xferFields, std::vector<value_type>(n * n * n, 0.0));
+    std::vector<value_type> commDataSend(3 * xferFields * faceSize);
+    std::vector<value_type> commDataRecv(3 * xferFields * faceSize);
+
+    auto ctx = empi::Context(&argc, &argv);
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    const auto prev = message_group->prec();
+    const auto next = message_group->next();
+
+    // Copies face of the receive buffer into the ghost fields
+    auto unpack = [&](int face) {
+        const value_type *srcAddr = &commDataRecv[face * xferFields * faceSize];
+        for(int fi = 0; fi < xferFields; ++fi) {
+            value_type *dest = ghosts[fi].data();
+            if(face == 0)
+                for(int i = 0; i < dx * dy; ++i) dest[i] = srcAddr[i];
+            else if(face == 1)
+                for(int i = 0; i < dz; ++i)
+                    for(int j = 0; j < dx; ++j) dest[i * dx * dy + j] = srcAddr[i * dx + j];
+            else
+                for(int i = 0; i < dz; ++i)
+                    for(int j = 0; j < dy; ++j) dest[i * dx * dy + j * dx] = srcAddr[i * dy + j];
+            srcAddr += faceSize;
+        }
+    };
+
+    // Copies the fields into face of the send buffer
+    auto pack = [&](int face) {
+        value_type *destAddr = &commDataSend[face * xferFields * faceSize];
+        for(int fi = 0; fi < xferFields; ++fi) {
+            const value_type *src = fields[fi].data();
+            if(face == 0) // plane
+                for(int i = 0; i < dx * dy; ++i) destAddr[i] = src[i];
+            else if(face == 1) // row
+                for(int i = 0; i < dz; ++i)
+                    for(int j = 0; j < dx; ++j) destAddr[i * dx + j] = src[i * dx * dy + j];
+            else // col
+                for(int i = 0; i < dz; ++i)
+                    for(int j = 0; j < dy; ++j) destAddr[i * dy + j] = src[i * dx * dy + j * dx];
+            destAddr += faceSize;
+        }
+    };
+
+    ex::thread_pool pool(threads);
+    ex::progress_loop loop;
+
+    auto exchange = [&](empi::MessageGroupHandler<value_type, empi::NOTAG, empi::NOSIZE> &mgh) {
+        // Unpacking stays on the loop thread, the faces overlap in the ghost fields
+        auto pipeline = [&](int face) {
+            auto send = ex::schedule(pool.get_scheduler()) | ex::then([&pack, face] { pack(face); }) |
+                        ex::continues_on(loop.get_scheduler()) | ex::let_value([&, face] {
+                            return ex::isend(mgh, &commDataSend[face * xferFields * faceSize], next,
+                                xferFields * faceSize, empi::Tag{face});
+                        });
+            auto recv = ex::irecv(mgh, &commDataRecv[face * xferFields * faceSize], prev, xferFields * faceSize,
+                            empi::Tag{face}) |
+                        ex::then([&unpack, face](int) { unpack(face); });
+            return ex::when_all(std::move(recv), std::move(send));
+        };
+        ex::sync_wait(loop, ex::when_all(pipeline(0), pipeline(1), pipeline(2)));
+    };
+
+    message_group->run([&](empi::MessageGroupHandler<value_type, empi::NOTAG, empi::NOSIZE> &mgh) {
+        // Warmup
+        exchange(mgh);
+        message_group->barrier();
+
+        if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) exchange(mgh);
+
+        message_group->barrier();
+        if(message_group->rank() == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) { cout << mpi_time << "\n"; }
+    return 0;
+} // end main
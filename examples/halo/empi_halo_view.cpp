@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Same halo exchange as empi_halo_pack, but every face of every field is sent
+// and received in place through a strided view: no staging buffer, no pack loops.
+// arg1: log2 of the block edge, arg2: number of iterations
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using value_type = double;
+
+int main(int argc, char **argv) {
+    double t_start, t_end;
+    double mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+    constexpr int xferFields = 3;
+    long pow_2_edge;
+    int n;
+    long max_iter;
+
+    pow_2_edge = strtol(argv[1], nullptr, 10);
+    n = static_cast<int>(std::pow(2, pow_2_edge));
+    max_iter = strtol(argv[2], nullptr, 10);
+
+    std::vector<std::vector<value_type>> fields(xferFields, std::vector<value_type>(n * n * n, 1.0));
+    std::vector<std::vector<value_type>> ghosts(xferFields, std::vector<value_type>(n * n * n, 0.0));
+
+    auto ctx = empi::Context(&argc, &argv);
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    const auto prev = message_group->prec();
+    const auto next = message_group->next();
+
+    // plane, row and col faces at the minimum corner of the block (z, y, x ordering)
+    const std::array<int, 3> sizes{n, n, n};
+    const std::array<std::array<int, 3>, 3> faces{{{1, n, n}, {n, 1, n}, {n, n, 1}}};
+    const std::array<int, 3> origin{0, 0, 0};
+
+    auto exchange = [&](empi::MessageGroupHandler<value_type, empi::NOTAG, empi::NOSIZE> &mgh) {
+        for(int face = 0; face < 3; face++)
+            for(int fi = 0; fi < xferFields; ++fi)
+                mgh.Irecv(empi::subarray(ghosts[fi].data(), sizes, faces[face], origin), prev,
+                    empi::Tag{face * xferFields + fi});
+        for(int face = 0; face < 3; face++)
+            for(int fi = 0; fi < xferFields; ++fi)
+                mgh.Isend(empi::subarray(fields[fi].data(), sizes, faces[face], origin), next,
+                    empi::Tag{face * xferFields + fi});
+        mgh.waitall();
+    };
+
+    message_group->run([&](empi::MessageGroupHandler<value_type, empi::NOTAG, empi::NOSIZE> &mgh) {
+        // Warmup
+        exchange(mgh);
+        message_group->barrier();
+
+        if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) exchange(mgh);
+
+        message_group->barrier();
+        if(message_group->rank() == 0) {
+            t_end = MPI_Wtime();
+            mpi_time = (t_end - t_start) * SCALE;
+        }
+    });
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) { cout << mpi_time << "\n"; }
+    return 0;
+} // end main
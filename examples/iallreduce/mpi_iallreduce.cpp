@@ -0,0 +1,62 @@
+#include <bits/stdc++.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <malloc.h>
+#include <mpi.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace std;
+using value_type = int;
+
+int main(int argc, char **argv) {
+    int myid, procs, n, err, max_iter, nBytes, sleep_time, range = 100, pow_2;
+    double t_start, t_end, t_start_inner;
+    constexpr int SCALE = 1000000;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+
+    // ------ PARAMETER SETUP -----------
+    pow_2 = static_cast<int>(strtol(argv[1], nullptr, 10));
+    max_iter = static_cast<int>(strtol(argv[2], nullptr, 10));
+
+    double mpi_time = 0.0;
+    nBytes = std::pow(2, pow_2);
+    n = nBytes;
+
+    std::vector<value_type> arr(n, 0);
+    std::vector<value_type> dest(n, 0);
+    MPI_Request request;
+
+    // Warmup
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Iallreduce(arr.data(), dest.data(), n, MPI_INT, MPI_SUM, MPI_COMM_WORLD, &request);
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // main measurement
+    if(myid == 0) t_start = MPI_Wtime();
+
+    for(auto iter = 0; iter < max_iter; iter++) {
+        MPI_Iallreduce(arr.data(), dest.data(), n, MPI_INT, MPI_SUM, MPI_COMM_WORLD, &request);
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if(myid == 0) {
+        t_end = MPI_Wtime();
+        mpi_time = (t_end - t_start) * SCALE;
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if(myid == 0) {
+        cout << mpi_time << "\n";
+    }
+    MPI_Finalize();
+    return 0;
+} // end main
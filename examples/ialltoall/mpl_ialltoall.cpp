@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <mpl/mpl.hpp>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using value_type = int;
+
+int main(int argc, char **argv) {
+    double t_start, t_end;
+    double mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+
+    int err;
+    long pow_2_bytes;
+    int n;
+    int myid;
+    long max_iter;
+
+    MPI_Status status;
+
+    // ------ PARAMETER SETUP -----------
+    pow_2_bytes = strtol(argv[1], nullptr, 10);
+    n = static_cast<int>(std::pow(2, pow_2_bytes));
+    max_iter = strtol(argv[2], nullptr, 10);
+
+    const mpl::communicator &comm_world(mpl::environment::comm_world());
+    // n elements are exchanged with every rank
+    std::vector<value_type> myarr(static_cast<size_t>(n) * comm_world.size());
+    std::vector<value_type> arr(static_cast<size_t>(n) * comm_world.size());
+
+    mpl::contiguous_layout<value_type> l(n);
+    mpl::irequest_pool events;
+
+    // Warmup
+    comm_world.barrier();
+    comm_world.ialltoall(myarr.data(), l, arr.data(), l).wait();
+    comm_world.barrier();
+
+    // main measurement
+    if(comm_world.rank() == 0) t_start = mpl::environment::wtime();
+
+    for(auto iter = 0; iter < max_iter; iter++) {
+        comm_world.ialltoall(myarr.data(), l, arr.data(), l).wait();
+    }
+
+    comm_world.barrier();
+    if(comm_world.rank() == 0) {
+        t_end = mpl::environment::wtime();
+        mpi_time = (t_end - t_start) * SCALE;
+    }
+
+    comm_world.barrier();
+
+    if(comm_world.rank() == 0) {
+        cout << mpi_time << "\n";
+    }
+    return 0;
+} // end main
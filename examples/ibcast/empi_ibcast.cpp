@@ -41,14 +41,14 @@ int main(int argc, char **argv) {
         // Warmup
         mgh.barrier();
         auto req = mgh.Ibcast(myarr.data(), 0, n);
-        req->wait<empi::details::no_status>();
+        req.wait<empi::details::no_status>();
         mgh.barrier();
 
         if(message_group->rank() == 0) t_start = MPI_Wtime();
 
         for(auto iter = 0; iter < max_iter; iter++) {
             auto req = mgh.Ibcast(myarr.data(), 0, n);
-            req->wait<empi::details::no_status>();
+            req.wait<empi::details::no_status>();
         }
 
         message_group->barrier();
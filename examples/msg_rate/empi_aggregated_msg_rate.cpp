@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Small message rate through empi::aggregator: same traffic as empi_msg_rate,
+// MESSAGES messages of 2^argv[1] bytes to each ring neighbor per iteration,
+// coalesced in batches of up to argv[3] bytes (default aggregator capacity).
+// Prints the messages sent per second by a process.
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <mpi.h>
+#include <vector>
+
+using namespace std;
+using value_type = char;
+
+constexpr int MESSAGES = 1024;
+
+int main(int argc, char **argv) {
+    double t_start, t_end, rate = 0.0;
+
+    empi::Context ctx(&argc, &argv);
+
+    // ------ PARAMETER SETUP -----------
+    const int pow_2 = static_cast<int>(strtol(argv[1], nullptr, 10));
+    const long max_iter = strtol(argv[2], nullptr, 10);
+    const size_t capacity = argc > 3 ? strtoul(argv[3], nullptr, 10) : empi::aggregator<value_type>::default_capacity;
+    const int n = static_cast<int>(std::pow(2, pow_2));
+
+    std::vector<value_type> sendbuf(n, 0);
+    std::vector<value_type> recvbuf(2 * MESSAGES * n, 0);
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    auto aggregator = message_group->aggregator<value_type>(capacity);
+    const auto prev = message_group->prec();
+    const auto next = message_group->next();
+    const empi::Tag tag{0};
+
+    auto exchange = [&] {
+        for(int m = 0; m < MESSAGES; m++) {
+            aggregator.send(sendbuf.data(), n, next, tag);
+            aggregator.send(sendbuf.data(), n, prev, tag);
+        }
+        aggregator.flush();
+        // Exactly this iteration's messages from each neighbor, a neighbor may already be sending the next ones
+        int received = 0;
+        for(const int source : prev == next ? std::vector<int>{prev} : std::vector<int>{prev, next}) {
+            const int expected = received + (prev == next ? 2 : 1) * MESSAGES;
+            while(received < expected)
+                for(auto message : aggregator.recv(source, tag))
+                    std::memcpy(recvbuf.data() + received++ * n, message.data(), message.size_bytes());
+        }
+        aggregator.waitall();
+    };
+
+    // Warmup
+    exchange();
+    message_group->barrier();
+
+    // main measurement
+    if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+    for(auto iter = 0; iter < max_iter; iter++) exchange();
+
+    message_group->barrier();
+    if(message_group->rank() == 0) {
+        t_end = MPI_Wtime();
+        rate = 2.0 * MESSAGES * static_cast<double>(max_iter) / (t_end - t_start);
+    }
+
+    if(message_group->rank() == 0) cout << rate << "\n";
+    return 0;
+} // end main
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Small message rate: every process sends MESSAGES messages of 2^argv[1] bytes
+// to each ring neighbor per iteration, one Isend each. Prints the messages
+// sent per second by a process, see empi_aggregated_msg_rate for the batched version.
+
+#include <cmath>
+#include <cstdlib>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <mpi.h>
+#include <vector>
+
+using namespace std;
+using value_type = char;
+
+constexpr int MESSAGES = 1024;
+
+int main(int argc, char **argv) {
+    double t_start, t_end, rate = 0.0;
+
+    empi::Context ctx(&argc, &argv);
+
+    // ------ PARAMETER SETUP -----------
+    const int pow_2 = static_cast<int>(strtol(argv[1], nullptr, 10));
+    const long max_iter = strtol(argv[2], nullptr, 10);
+    const int n = static_cast<int>(std::pow(2, pow_2));
+
+    std::vector<value_type> sendbuf(n, 0);
+    std::vector<value_type> recvbuf(2 * MESSAGES * n, 0);
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    const auto prev = message_group->prec();
+    const auto next = message_group->next();
+
+    message_group->run([&](empi::MessageGroupHandler<value_type, empi::Tag{0}, empi::NOSIZE> &mgh) {
+        auto exchange = [&] {
+            for(int m = 0; m < MESSAGES; m++) {
+                mgh.Irecv(recvbuf.data() + 2 * m * n, prev, n);
+                mgh.Irecv(recvbuf.data() + (2 * m + 1) * n, next, n);
+                mgh.Isend(sendbuf.data(), next, n);
+                mgh.Isend(sendbuf.data(), prev, n);
+            }
+            mgh.waitall();
+        };
+
+        // Warmup
+        exchange();
+        message_group->barrier();
+
+        // main measurement
+        if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+        for(auto iter = 0; iter < max_iter; iter++) exchange();
+
+        message_group->barrier();
+        if(message_group->rank() == 0) {
+            t_end = MPI_Wtime();
+            rate = 2.0 * MESSAGES * static_cast<double>(max_iter) / (t_end - t_start);
+        }
+    });
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) cout << rate << "\n";
+    return 0;
+} // end main
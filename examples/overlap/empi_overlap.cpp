@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Communication/computation overlap: pairs of processes exchange 2^argv[1] bytes
+// with Isend/Irecv around a compute kernel as long as the exchange alone.
+// argv[3] "progress" starts the Context progress thread, pinned to core argv[4]
+// if given. Prints the overlap percentage,
+// 100 * (1 - (t_total - t_compute) / t_comm), clamped to [0, 100].
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+using value_type = char;
+
+volatile double sink;
+
+// Dependent chain of multiply-adds, work iterations long
+static void compute(long work) {
+    double x = 1.0;
+    for(long i = 0; i < work; i++) x = x * 1.0000001 + 1e-9;
+    sink = x;
+}
+
+int main(int argc, char **argv) {
+    double overlap = 0.0;
+
+    empi::Context ctx(&argc, &argv);
+
+    // ------ PARAMETER SETUP -----------
+    const int pow_2 = static_cast<int>(strtol(argv[1], nullptr, 10));
+    const long max_iter = strtol(argv[2], nullptr, 10);
+    const int n = static_cast<int>(std::pow(2, pow_2));
+    if(argc > 3 && std::string(argv[3]) == "progress")
+        ctx.start_progress({argc > 4 ? static_cast<int>(strtol(argv[4], nullptr, 10)) : -1});
+
+    std::vector<value_type> sendbuf(n, 0);
+    std::vector<value_type> recvbuf(n, 0);
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    const int rank = message_group->rank();
+    const int partner = (rank ^ 1) < message_group->size() ? (rank ^ 1) : MPI_PROC_NULL;
+
+    message_group->run([&](empi::MessageGroupHandler<value_type, empi::Tag{0}, empi::NOSIZE> &mgh) {
+        auto post = [&] {
+            mgh.Irecv(recvbuf.data(), partner, n);
+            mgh.Isend(sendbuf.data(), partner, n);
+        };
+        // Mean time of body over max_iter synchronized runs, the slowest process counts
+        auto measure = [&](auto &&body) {
+            double total = 0.0;
+            for(long iter = 0; iter < max_iter; iter++) {
+                message_group->barrier();
+                const double start = MPI_Wtime();
+                body();
+                total += MPI_Wtime() - start;
+            }
+            double mean = total / static_cast<double>(max_iter);
+            MPI_Allreduce(MPI_IN_PLACE, &mean, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+            return mean;
+        };
+
+        // Warmup
+        post();
+        mgh.waitall();
+
+        const double t_comm = measure([&] {
+            post();
+            mgh.waitall();
+        });
+
+        // Kernel as long as the exchange
+        constexpr long calibration = 1 << 22;
+        double start = MPI_Wtime();
+        compute(calibration);
+        double rate = calibration / (MPI_Wtime() - start);
+        MPI_Allreduce(MPI_IN_PLACE, &rate, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+        const long work = static_cast<long>(rate * t_comm);
+
+        const double t_compute = measure([&] { compute(work); });
+        const double t_total = measure([&] {
+            post();
+            compute(work);
+            mgh.waitall();
+        });
+
+        if(t_comm > 0.0) overlap = std::clamp(100.0 * (1.0 - (t_total - t_compute) / t_comm), 0.0, 100.0);
+    });
+
+    message_group->barrier();
+
+    if(rank == 0) cout << overlap << "\n";
+    return 0;
+} // end main
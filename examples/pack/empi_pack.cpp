@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Pack microbenchmark: gathers 2^arg1 doubles laid out as blocks of blocklength
+// elements, stride elements apart, into a contiguous buffer, and scatters them
+// back. For each (blocklength, stride) pair rank 0 prints the mean time in us of
+// MPI_Pack/MPI_Unpack on the equivalent MPI_Type_vector and of every EMPI kernel
+// supported by this CPU. Single process, prints a table: not part of minibench.
+// arg1: log2 of the number of packed elements, arg2: number of iterations
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using value_type = double;
+
+template<typename F>
+double time_us(long max_iter, F &&f) {
+    f(); // Warmup
+    const double t_start = MPI_Wtime();
+    for(auto iter = 0; iter < max_iter; iter++) f();
+    return (MPI_Wtime() - t_start) * 1000000 / static_cast<double>(max_iter);
+}
+
+int main(int argc, char **argv) {
+    long pow_2;
+    int n;
+    long max_iter;
+
+    pow_2 = strtol(argv[1], nullptr, 10);
+    n = static_cast<int>(std::pow(2, pow_2));
+    max_iter = strtol(argv[2], nullptr, 10);
+
+    auto ctx = empi::Context(&argc, &argv);
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    if(message_group->rank() != 0) return 0;
+
+    const empi::simd_isa best = empi::simd_level();
+    const char *names[] = {"scalar", "avx2", "avx512"};
+    printf("%11s %6s %10s %10s", "blocklength", "stride", "MPI_Pack", "MPI_Unpack");
+    for(int isa = 0; isa <= static_cast<int>(best); isa++) printf(" %8s(p) %8s(u)", names[isa], names[isa]);
+    printf("\n");
+
+    std::vector<value_type> staging(n);
+    for(int blocklength = 1; blocklength <= 64; blocklength *= 4) {
+        for(int factor : {2, 4, 16}) {
+            const int stride = blocklength * factor;
+            const int count = n / blocklength;
+            std::vector<value_type> field(static_cast<size_t>(count) * stride, 1.0);
+
+            MPI_Datatype vector;
+            MPI_Type_vector(count, blocklength, stride, MPI_DOUBLE, &vector);
+            MPI_Type_commit(&vector);
+            const int bytes = n * static_cast<int>(sizeof(value_type));
+            const double mpi_pack = time_us(max_iter, [&] {
+                int position = 0;
+                MPI_Pack(field.data(), 1, vector, staging.data(), bytes, &position, MPI_COMM_SELF);
+            });
+            const double mpi_unpack = time_us(max_iter, [&] {
+                int position = 0;
+                MPI_Unpack(staging.data(), bytes, &position, field.data(), 1, vector, MPI_COMM_SELF);
+            });
+            MPI_Type_free(&vector);
+
+            printf("%11d %6d %10.3f %10.3f", blocklength, stride, mpi_pack, mpi_unpack);
+            for(int i = 0; i <= static_cast<int>(best); i++) {
+                const auto isa = static_cast<empi::simd_isa>(i);
+                const double pack = time_us(max_iter, [&] {
+                    empi::details::pack_with(isa, field.data(), staging.data(), count, blocklength, stride);
+                });
+                const double unpack = time_us(max_iter, [&] {
+                    empi::details::unpack_with(isa, staging.data(), field.data(), count, blocklength, stride);
+                });
+                printf(" %11.3f %11.3f", pack, unpack);
+            }
+            printf("\n");
+        }
+    }
+    return 0;
+} // end main
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <malloc.h>
+#include <mpi.h>
+#include <optional>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+
+int main(int argc, char **argv) {
+    int myid, procs, n, err, max_iter, nBytes, sleep_time, iter = 0, range = 100, pow_2;
+    double t_start, t_end, t_start_inner;
+    constexpr int SCALE = 1000000;
+
+    empi::Context ctx(&argc, &argv);
+
+    // ------ PARAMETER SETUP -----------
+    pow_2 = atoi(argv[1]);
+    max_iter = atoi(argv[2]);
+
+    double mpi_time = 0.0;
+    nBytes = std::pow(2, pow_2);
+    n = nBytes;
+    std::vector<char> myarr(n, 0);
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    MPI_Status status;
+    const int rank = message_group->rank();
+
+    // Each side puts the message in the other's window: rank 0 opens an access
+    // epoch to 1 while 1 exposes its window to 0, then the roles swap.
+    // argv[3] fence: a single fence epoch instead, one fence after each put
+    auto window = message_group->create_window<char>(n);
+    const int peer = 1 - rank;
+    std::optional<empi::rma_epoch> fence;
+    if(argc > 3 && std::string(argv[3]) == "fence") fence.emplace(window.fence());
+    auto ping_pong = [&] {
+        if(fence) {
+            if(rank == 0) window.put(myarr.data(), n, peer, 0);
+            fence->fence();
+            if(rank == 1) window.put(myarr.data(), n, peer, 0);
+            fence->fence();
+        } else if(rank == 0) {
+            {
+                auto epoch = window.access({peer});
+                window.put(myarr.data(), n, peer, 0);
+            }
+            auto epoch = window.exposure({peer});
+        } else {
+            { auto epoch = window.exposure({peer}); }
+            auto epoch = window.access({peer});
+            window.put(myarr.data(), n, peer, 0);
+        }
+    };
+
+    // Warm up
+    message_group->barrier();
+    ping_pong();
+    message_group->barrier();
+
+    if(message_group->rank() == 0) t_start = MPI_Wtime();
+
+    for(auto iter = 0; iter < max_iter; iter++) ping_pong();
+
+    message_group->barrier();
+    if(message_group->rank() == 0) {
+        t_end = MPI_Wtime();
+        mpi_time = (t_end - t_start) * SCALE;
+    }
+
+    message_group->barrier();
+
+    if(message_group->rank() == 0) {
+        cout << mpi_time << "\n";
+    }
+    return 0;
+} // end main
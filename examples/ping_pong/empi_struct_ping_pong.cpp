@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <mpi.h>
+#include <vector>
+
+using namespace std;
+
+// Ping-pong of 2^pow_2 aggregates with derived datatypes: padded particles
+// (MPI_Type_create_struct, enum member sent as its underlying type), then
+// packed readings (raw bytes). Rank 1 checks the warm up round trip of both;
+// the time printed is the sum of the two.
+
+enum class kind : short { fluid, solid, boundary };
+
+struct particle {
+    double position[3];
+    kind type;
+    int id;
+};
+
+struct reading {
+    int key;
+    float value;
+};
+
+// Packed, but its pointer cannot be sent: make_aggregate_type rejects it
+struct buffer_ref {
+    double *data;
+    long size;
+};
+
+static_assert(!empi::details::is_packed_v<particle>);
+static_assert(empi::details::is_packed_v<reading>);
+static_assert(empi::details::is_packed_v<buffer_ref> && !empi::details::has_sendable_leaves<buffer_ref>());
+
+int main(int argc, char **argv) {
+    int pow_2, max_iter, n;
+    double mpi_time = 0.0;
+    constexpr int SCALE = 1000000;
+
+    empi::Context ctx(&argc, &argv);
+
+    // ------ PARAMETER SETUP -----------
+    pow_2 = atoi(argv[1]);
+    max_iter = atoi(argv[2]);
+    n = std::pow(2, pow_2);
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    MPI_Status status;
+    const int rank = message_group->rank();
+
+    std::vector<particle> particles(n);
+    std::vector<reading> readings(n);
+    if(rank == 0) {
+        for(int i = 0; i < n; i++) {
+            particles[i] = {{i * 1.0, i * 2.0, i * 3.0}, static_cast<kind>(i % 3), i};
+            readings[i] = {i, i * 0.5f};
+        }
+    }
+
+    auto ping_pong = [&](auto &mgh, auto &data, auto expected) {
+        auto round_trip = [&] {
+            if(rank == 0) {
+                mgh.send(data.data(), 1, n);
+                mgh.recv(data.data(), 1, n, status);
+            } else {
+                mgh.recv(data.data(), 0, n, status);
+                mgh.send(data.data(), 0, n);
+            }
+        };
+
+        // Warm up
+        mgh.barrier();
+        round_trip();
+        if(rank == 1) {
+            for(int i = 0; i < n; i++) {
+                if(!expected(data[i], i)) {
+                    cerr << "element " << i << " corrupted\n";
+                    MPI_Abort(MPI_COMM_WORLD, 1);
+                }
+            }
+        }
+        mgh.barrier();
+
+        const double t_start = MPI_Wtime();
+        for(int iter = 0; iter < max_iter; iter++) round_trip();
+        mgh.barrier();
+        mpi_time += (MPI_Wtime() - t_start) * SCALE;
+    };
+
+    message_group->run([&](empi::MessageGroupHandler<particle, empi::Tag{0}, empi::NOSIZE> &mgh) {
+        ping_pong(mgh, particles, [](const particle &p, int i) {
+            return p.position[0] == i * 1.0 && p.position[1] == i * 2.0 && p.position[2] == i * 3.0 &&
+                   p.type == static_cast<kind>(i % 3) && p.id == i;
+        });
+    });
+
+    message_group->run([&](empi::MessageGroupHandler<reading, empi::Tag{1}, empi::NOSIZE> &mgh) {
+        ping_pong(mgh, readings, [](const reading &r, int i) { return r.key == i && r.value == i * 0.5f; });
+    });
+
+    message_group->barrier();
+
+    if(rank == 0) cout << mpi_time << "\n";
+    return 0;
+} // end main
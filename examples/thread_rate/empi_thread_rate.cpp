@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+// Stress benchmark for MPI_THREAD_MULTIPLE: every thread posts windows of
+// Isend/Irecv on the same MessageGroupHandler (hence the same request_pool)
+// and the Isend/Irecv rate is reported for 1, 2, 4, ... threads.
+
+#include <cmath>
+#include <cstdlib>
+#include <empi/empi.hpp>
+#include <iostream>
+#include <mpi.h>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using value_type = char;
+
+constexpr int WINDOW = 64;
+
+int main(int argc, char **argv) {
+    empi::Context ctx(&argc, &argv);
+
+    // ------ PARAMETER SETUP -----------
+    const int pow_2 = static_cast<int>(strtol(argv[1], nullptr, 10));
+    const long max_iter = strtol(argv[2], nullptr, 10);
+    const int max_threads = argc > 3 ? static_cast<int>(strtol(argv[3], nullptr, 10))
+                                     : static_cast<int>(std::thread::hardware_concurrency());
+    const int n = static_cast<int>(std::pow(2, pow_2));
+
+    auto message_group = ctx.create_message_group(MPI_COMM_WORLD);
+    const int rank = message_group->rank();
+    const int partner = (rank ^ 1) < message_group->size() ? (rank ^ 1) : MPI_PROC_NULL;
+
+    message_group->run([&](empi::MessageGroupHandler<value_type, empi::NOTAG, empi::NOSIZE> &mgh) {
+        for(int num_threads = 1; num_threads <= max_threads; num_threads <<= 1) {
+            std::vector<std::vector<value_type>> sendbuf(num_threads, std::vector<value_type>(n, 0));
+            std::vector<std::vector<value_type>> recvbuf(num_threads, std::vector<value_type>(n * WINDOW, 0));
+
+            auto worker = [&](int id) {
+                const empi::Tag tag{id};
+                for(long iter = 0; iter < max_iter; iter++) {
+                    for(int w = 0; w < WINDOW; w++) {
+                        mgh.Irecv(recvbuf[id].data() + w * n, partner, n, tag);
+                        mgh.Isend(sendbuf[id].data(), partner, n, tag);
+                    }
+                    mgh.waitall_local();
+                }
+            };
+
+            mgh.barrier();
+            const double t_start = MPI_Wtime();
+            std::vector<std::thread> threads;
+            for(int id = 0; id < num_threads; id++) threads.emplace_back(worker, id);
+            for(auto &t : threads) t.join();
+            mgh.barrier();
+            const double elapsed = MPI_Wtime() - t_start;
+
+            if(rank == 0) {
+                const double ops = 2.0 * WINDOW * static_cast<double>(max_iter) * num_threads;
+                cout << num_threads << " " << ops / elapsed << "\n";
+            }
+        }
+    });
+
+    message_group->barrier();
+    return 0;
+} // end main
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <mpi.h>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+constexpr int WINDOW = 64;
+
+int main(int argc, char **argv) {
+    int provided, _rank, _size;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+    if(provided < MPI_THREAD_MULTIPLE) {
+        cout << "\nMPI_THREAD_MULTIPLE is not supported.\n";
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    const int pow_2 = static_cast<int>(strtol(argv[1], nullptr, 10));
+    const long max_iter = strtol(argv[2], nullptr, 10);
+    const int max_threads = argc > 3 ? static_cast<int>(strtol(argv[3], nullptr, 10))
+                                     : static_cast<int>(std::thread::hardware_concurrency());
+    const int n = static_cast<int>(std::pow(2, pow_2));
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &_size);
+    const int partner = (_rank ^ 1) < _size ? (_rank ^ 1) : MPI_PROC_NULL;
+
+    for(int num_threads = 1; num_threads <= max_threads; num_threads <<= 1) {
+        std::vector<std::vector<char>> sendbuf(num_threads, std::vector<char>(n, 0));
+        std::vector<std::vector<char>> recvbuf(num_threads, std::vector<char>(n * WINDOW, 0));
+
+        auto worker = [&](int id) {
+            MPI_Request requests[2 * WINDOW];
+            for(long iter = 0; iter < max_iter; iter++) {
+                for(int w = 0; w < WINDOW; w++) {
+                    MPI_Irecv(recvbuf[id].data() + w * n, n, MPI_CHAR, partner, id, MPI_COMM_WORLD, &requests[2 * w]);
+                    MPI_Isend(sendbuf[id].data(), n, MPI_CHAR, partner, id, MPI_COMM_WORLD, &requests[2 * w + 1]);
+                }
+                MPI_Waitall(2 * WINDOW, requests, MPI_STATUSES_IGNORE);
+            }
+        };
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        const double t_start = MPI_Wtime();
+        std::vector<std::thread> threads;
+        for(int id = 0; id < num_threads; id++) threads.emplace_back(worker, id);
+        for(auto &t : threads) t.join();
+        MPI_Barrier(MPI_COMM_WORLD);
+        const double elapsed = MPI_Wtime() - t_start;
+
+        if(_rank == 0) {
+            const double ops = 2.0 * WINDOW * static_cast<double>(max_iter) * num_threads;
+            cout << num_threads << " " << ops / elapsed << "\n";
+        }
+    }
+
+    MPI_Finalize();
+    return 0;
+} // end main
@@ -62,7 +62,7 @@ void f(std::unique_ptr<empi::MessageGroup> &comm_world) {
         u_old_l[i] = u_0(x);
         u_l[i] = 0.5 * eps * (u_0(x - dx) + u_0(x + dx)) + (1.0 - eps) * u_0(x) + dt * u_0_dt(x);
     }
-    std::shared_ptr<empi::async_event> events[4];
+    empi::async_event events[4];
     // propagate
     comm_world->run([&](empi::MessageGroupHandler<double, empi::NOTAG, 1> &cgh) {
         // propagate
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_AGGREGATE_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_AGGREGATE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace empi::details {
+
+// Minimal compile-time reflection for aggregates, used to derive MPI datatypes.
+// Supported types are aggregates without base classes whose members are
+// arithmetic types, C/std arrays or other supported aggregates.
+
+template<typename T>
+struct is_std_array : std::false_type {};
+
+template<typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type {};
+
+// Element type and number of elements of a (possibly multidimensional) array member
+template<typename T>
+struct array_traits {
+    using type = T;
+    static constexpr std::size_t extent = 1;
+};
+
+template<typename T, std::size_t N>
+struct array_traits<T[N]> {
+    using type = typename array_traits<T>::type;
+    static constexpr std::size_t extent = N * array_traits<T>::extent;
+};
+
+template<typename T, std::size_t N>
+struct array_traits<std::array<T, N>> {
+    using type = typename array_traits<T>::type;
+    static constexpr std::size_t extent = N * array_traits<T>::extent;
+};
+
+template<typename T>
+concept reflectable = std::is_aggregate_v<T> && !std::is_array_v<T> && !is_std_array<T>::value &&
+                      std::is_default_constructible_v<T> && std::is_trivially_copyable_v<T>;
+
+// Converts to any member type. Only used in unevaluated contexts.
+struct any_field {
+    template<typename T>
+    constexpr operator T() const noexcept;
+};
+
+constexpr std::size_t max_fields = 16;
+
+// Each member is initialized from its own braces, so array members count as one field
+// instead of being expanded by brace elision.
+template<typename T, typename... Fields>
+consteval std::size_t field_count() {
+    if constexpr(sizeof...(Fields) < max_fields && requires { T{{Fields{}}..., {any_field{}}}; }) {
+        return field_count<T, Fields..., any_field>();
+    } else {
+        return sizeof...(Fields);
+    }
+}
+
+// Calls f on every member of t, in declaration order
+template<reflectable T, typename F>
+constexpr void for_each_field(T &t, F &&f) {
+    constexpr std::size_t n = field_count<T>();
+    static_assert(n > 0 && n <= max_fields, "Unsupported aggregate: too many members");
+    if constexpr(n == 1) {
+        auto &[a] = t;
+        f(a);
+    } else if constexpr(n == 2) {
+        auto &[a, b] = t;
+        f(a), f(b);
+    } else if constexpr(n == 3) {
+        auto &[a, b, c] = t;
+        f(a), f(b), f(c);
+    } else if constexpr(n == 4) {
+        auto &[a, b, c, d] = t;
+        f(a), f(b), f(c), f(d);
+    } else if constexpr(n == 5) {
+        auto &[a, b, c, d, e] = t;
+        f(a), f(b), f(c), f(d), f(e);
+    } else if constexpr(n == 6) {
+        auto &[a, b, c, d, e, g] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g);
+    } else if constexpr(n == 7) {
+        auto &[a, b, c, d, e, g, h] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h);
+    } else if constexpr(n == 8) {
+        auto &[a, b, c, d, e, g, h, i] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h), f(i);
+    } else if constexpr(n == 9) {
+        auto &[a, b, c, d, e, g, h, i, j] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h), f(i), f(j);
+    } else if constexpr(n == 10) {
+        auto &[a, b, c, d, e, g, h, i, j, k] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h), f(i), f(j), f(k);
+    } else if constexpr(n == 11) {
+        auto &[a, b, c, d, e, g, h, i, j, k, l] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h), f(i), f(j), f(k), f(l);
+    } else if constexpr(n == 12) {
+        auto &[a, b, c, d, e, g, h, i, j, k, l, m] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h), f(i), f(j), f(k), f(l), f(m);
+    } else if constexpr(n == 13) {
+        auto &[a, b, c, d, e, g, h, i, j, k, l, m, o] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h), f(i), f(j), f(k), f(l), f(m), f(o);
+    } else if constexpr(n == 14) {
+        auto &[a, b, c, d, e, g, h, i, j, k, l, m, o, p] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h), f(i), f(j), f(k), f(l), f(m), f(o), f(p);
+    } else if constexpr(n == 15) {
+        auto &[a, b, c, d, e, g, h, i, j, k, l, m, o, p, q] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h), f(i), f(j), f(k), f(l), f(m), f(o), f(p), f(q);
+    } else {
+        auto &[a, b, c, d, e, g, h, i, j, k, l, m, o, p, q, r] = t;
+        f(a), f(b), f(c), f(d), f(e), f(g), f(h), f(i), f(j), f(k), f(l), f(m), f(o), f(p), f(q), f(r);
+    }
+}
+
+// Sum of the sizes of all the scalar leaves of T
+template<typename T>
+consteval std::size_t packed_size() {
+    using leaf = typename array_traits<T>::type;
+    if constexpr(reflectable<leaf>) {
+        std::size_t size = 0;
+        leaf t{};
+        for_each_field(t, [&size](auto &member) { size += packed_size<std::remove_cvref_t<decltype(member)>>(); });
+        return size * array_traits<T>::extent;
+    } else {
+        return sizeof(T);
+    }
+}
+
+// True when every scalar leaf of T is arithmetic or an enum: pointers, whose
+// values mean nothing on another process, make the whole aggregate unsendable
+template<typename T>
+consteval bool has_sendable_leaves() {
+    using leaf = typename array_traits<T>::type;
+    if constexpr(reflectable<leaf>) {
+        bool sendable = true;
+        leaf t{};
+        for_each_field(t, [&sendable](auto &member) {
+            sendable = sendable && has_sendable_leaves<std::remove_cvref_t<decltype(member)>>();
+        });
+        return sendable;
+    } else {
+        return std::is_arithmetic_v<leaf> || std::is_enum_v<leaf>;
+    }
+}
+
+// True when T has no padding anywhere, so that it can be moved around as raw bytes
+template<typename T>
+constexpr bool is_packed_v = packed_size<T>() == sizeof(T);
+
+} // namespace empi::details
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_AGGREGATE_HPP_
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_AGGREGATOR_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_AGGREGATOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <empi/async_event.hpp>
+#include <empi/request_pool.hpp>
+#include <empi/tag.hpp>
+
+namespace empi {
+
+namespace details {
+
+// Batch layout: the number of messages, then one record per message, its
+// element count followed by the elements. Headers and records are padded to
+// the alignment of T so the elements can be read in place.
+template<typename T>
+struct batch_layout {
+    static constexpr size_t align = std::max(alignof(T), alignof(std::uint32_t));
+    static constexpr size_t header = (sizeof(std::uint32_t) + align - 1) / align * align;
+
+    static constexpr size_t record(size_t count) { return header + (count * sizeof(T) + align - 1) / align * align; }
+};
+
+// What the group sees of its aggregators
+class flushable {
+  public:
+    virtual void flush() = 0;
+
+  protected:
+    ~flushable() = default;
+};
+
+// Live aggregators of a group, flushed by its wait_all. Shared with them, as
+// an aggregator may outlive its group.
+class aggregator_registry {
+  public:
+    void add(flushable *aggregator) {
+        std::lock_guard lock(mutex);
+        aggregators.push_back(aggregator);
+    }
+
+    void replace(flushable *from, flushable *to) {
+        std::lock_guard lock(mutex);
+        std::replace(aggregators.begin(), aggregators.end(), from, to);
+    }
+
+    void remove(flushable *aggregator) {
+        std::lock_guard lock(mutex);
+        std::erase(aggregators, aggregator);
+    }
+
+    void flush_all() {
+        std::lock_guard lock(mutex);
+        for(auto *aggregator : aggregators) aggregator->flush();
+    }
+
+  private:
+    std::mutex mutex;
+    std::vector<flushable *> aggregators;
+};
+
+} // namespace details
+
+// Messages of a batch received by aggregator::recv, iterated as std::span<const T>
+template<typename T>
+class batch {
+    using layout = details::batch_layout<T>;
+
+  public:
+    class iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::span<const T>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(const std::byte *record) : record(record) {}
+
+        value_type operator*() const {
+            return {reinterpret_cast<const T *>(record + layout::header), count()};
+        }
+
+        iterator &operator++() {
+            record += layout::record(count());
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const iterator &other) const = default;
+
+      private:
+        [[nodiscard]] std::uint32_t count() const {
+            std::uint32_t n;
+            std::memcpy(&n, record, sizeof(n));
+            return n;
+        }
+
+        const std::byte *record = nullptr;
+    };
+
+    batch() = default;
+    batch(std::vector<std::byte> data, int source, int tag) : data(std::move(data)), _source(source), _tag(tag) {}
+
+    [[nodiscard]] iterator begin() const { return iterator(data.empty() ? nullptr : data.data() + layout::header); }
+
+    [[nodiscard]] iterator end() const { return iterator(data.empty() ? nullptr : data.data() + data.size()); }
+
+    // Number of messages
+    [[nodiscard]] size_t size() const {
+        std::uint32_t n = 0;
+        if(!data.empty()) std::memcpy(&n, data.data(), sizeof(n));
+        return n;
+    }
+
+    [[nodiscard]] int source() const { return _source; }
+
+    [[nodiscard]] int tag() const { return _tag; }
+
+  private:
+    std::vector<std::byte> data;
+    int _source = MPI_PROC_NULL;
+    int _tag = MPI_ANY_TAG;
+};
+
+// Coalesces small messages to the same (dest, tag) into a single MPI message,
+// created by MessageGroup::aggregator. A batch is sent when its staging buffer
+// is full, on flush(), on waitall() and on wait_all() of the group; staging
+// buffers of completed batches are reused. The receiver gets one batch per recv() and iterates its messages
+// in send order:
+//
+//     agg.send(p.data(), 3, dest, Tag{0}); ... agg.flush();
+//     for(std::span<const double> m : agg.recv(source, Tag{0})) ...
+//
+// A batch only matches recv() of an aggregator of the same group, its messages
+// never match the group's point to point receives.
+template<typename T>
+class aggregator : public details::flushable {
+    static_assert(std::is_trivially_copyable_v<T>, "aggregated messages are sent as bytes");
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "elements are read in place from a byte vector");
+    using layout = details::batch_layout<T>;
+
+  public:
+    static constexpr size_t default_capacity = 8192;
+
+    // registry, if any, is the one of the group flushing this aggregator
+    aggregator(MPI_Comm parent, size_t capacity, std::shared_ptr<request_pool> pool,
+        std::shared_ptr<details::aggregator_registry> registry = nullptr)
+        : capacity(std::max(capacity, layout::header + layout::record(1))), _request_pool(std::move(pool)),
+          registry(std::move(registry)) {
+        MPI_Comm_dup(parent, &comm);
+        if(this->registry) this->registry->add(this);
+    }
+
+    aggregator(const aggregator &) = delete;
+    aggregator &operator=(const aggregator &) = delete;
+
+    aggregator(aggregator &&other) noexcept
+        : capacity(other.capacity), _request_pool(std::move(other._request_pool)),
+          registry(std::move(other.registry)), comm(std::exchange(other.comm, MPI_COMM_NULL)),
+          staging(std::move(other.staging)), in_flight(std::move(other.in_flight)), spare(std::move(other.spare)) {
+        if(registry) registry->replace(&other, this);
+    }
+
+    ~aggregator() {
+        if(registry) registry->remove(this);
+        if(comm == MPI_COMM_NULL) return;
+        waitall();
+        MPI_Comm_free(&comm);
+    }
+
+    // Queue count elements for dest, sending the (dest, tag) batch first if they do not fit.
+    // A message larger than the capacity goes in a batch of its own.
+    void send(const T *data, int count, int dest, Tag tag) {
+        auto &buffer = staging_of(dest, tag.value);
+        const size_t record = layout::record(count);
+        if(buffer.size() > layout::header && buffer.size() + record > capacity) send_batch(dest, tag.value, buffer);
+        if(buffer.empty()) buffer.resize(layout::header);
+
+        const size_t offset = buffer.size();
+        buffer.resize(offset + record);
+        const auto n = static_cast<std::uint32_t>(count);
+        std::memcpy(buffer.data() + offset, &n, sizeof(n));
+        std::memcpy(buffer.data() + offset + layout::header, data, count * sizeof(T));
+        std::uint32_t messages;
+        std::memcpy(&messages, buffer.data(), sizeof(messages));
+        messages++;
+        std::memcpy(buffer.data(), &messages, sizeof(messages));
+
+        if(buffer.size() >= capacity) send_batch(dest, tag.value, buffer);
+    }
+
+    void send(const T &value, int dest, Tag tag) { send(&value, 1, dest, tag); }
+
+    // Send every batch holding at least one message
+    void flush() override {
+        for(auto &[key, buffer] : staging)
+            if(!buffer.empty()) send_batch(key.first, key.second, buffer);
+    }
+
+    // flush() and wait until every batch sent so far is delivered
+    void waitall() {
+        flush();
+        for(auto &[event, buffer] : in_flight) {
+            event.template wait<details::no_status>();
+            recycle(std::move(buffer));
+        }
+        in_flight.clear();
+    }
+
+    // Next batch from source (or MPI_ANY_SOURCE) with tag
+    [[nodiscard]] batch<T> recv(int source, Tag tag) {
+        MPI_Message message;
+        MPI_Status status;
+        MPI_Mprobe(source, tag.value, comm, &message, &status);
+        int bytes;
+        MPI_Get_count(&status, MPI_BYTE, &bytes);
+        std::vector<std::byte> data(bytes);
+        MPI_Mrecv(data.data(), bytes, MPI_BYTE, &message, MPI_STATUS_IGNORE);
+        return {std::move(data), status.MPI_SOURCE, status.MPI_TAG};
+    }
+
+    // Messages queued and not sent yet, over every (dest, tag)
+    [[nodiscard]] size_t pending() const {
+        size_t messages = 0;
+        for(const auto &[key, buffer] : staging) {
+            std::uint32_t n = 0;
+            if(!buffer.empty()) std::memcpy(&n, buffer.data(), sizeof(n));
+            messages += n;
+        }
+        return messages;
+    }
+
+  private:
+    std::vector<std::byte> &staging_of(int dest, int tag) {
+        const auto key = std::make_pair(dest, tag);
+        if(last != staging.end() && last->first == key) return last->second;
+        last = staging.try_emplace(key).first;
+        return last->second;
+    }
+
+    // Post the batch and replace buffer with a recycled one
+    void send_batch(int dest, int tag, std::vector<std::byte> &buffer) {
+        auto event = _request_pool->get_req();
+        event.res = MPI_Isend(buffer.data(), static_cast<int>(buffer.size()), MPI_BYTE, dest, tag, comm,
+            event.get_request());
+        in_flight.emplace_back(event, std::move(buffer));
+        buffer = take_spare();
+    }
+
+    // Staging buffer of the oldest delivered batch, if any, else a new one
+    std::vector<std::byte> take_spare() {
+        while(!in_flight.empty() && delivered(in_flight.front().first)) {
+            recycle(std::move(in_flight.front().second));
+            in_flight.pop_front();
+        }
+        if(spare.empty()) {
+            std::vector<std::byte> buffer;
+            buffer.reserve(capacity);
+            return buffer;
+        }
+        auto buffer = std::move(spare.back());
+        spare.pop_back();
+        return buffer;
+    }
+
+    void recycle(std::vector<std::byte> buffer) {
+        buffer.clear();
+        spare.push_back(std::move(buffer));
+    }
+
+    static bool delivered(const async_event &event) {
+        MPI_Request *request = event.get_request();
+        if(request == nullptr) return true;
+        int flag;
+        MPI_Test(request, &flag, MPI_STATUS_IGNORE);
+        return flag;
+    }
+
+    using staging_map = std::map<std::pair<int, int>, std::vector<std::byte>>;
+
+    size_t capacity;
+    std::shared_ptr<request_pool> _request_pool;
+    std::shared_ptr<details::aggregator_registry> registry;
+    MPI_Comm comm = MPI_COMM_NULL;
+    staging_map staging; // By (dest, tag), the header is written by the first message
+    typename staging_map::iterator last = staging.end(); // Most recent (dest, tag), senders often repeat it
+    std::deque<std::pair<async_event, std::vector<std::byte>>> in_flight;
+    std::vector<std::vector<std::byte>> spare;
+};
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_AGGREGATOR_HPP_
@@ -6,40 +6,187 @@
 #define INCLUDE_EMPI_ASYNC_EVENT
 
 #include "empi/datatype.hpp"
+#include <empi/request_ring.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mpi.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace empi {
 
+class continuation;
+
+// Trivially copyable handle to a request living in a request_ring.
+// The ticket selects the slot and its generation: once the slot is recycled
+// for a newer request the handle becomes stale. A slot is only recycled after
+// its request completed, so waiting on a stale handle returns immediately.
 struct async_event {
-    constexpr async_event() : res(-1) { request = std::make_unique<MPI_Request>(MPI_REQUEST_NULL); }
+    constexpr async_event() : ring(nullptr), ticket(details::request_ring::no_ticket), res(-1) {}
 
-    async_event &operator=(async_event &&e) noexcept {
-        res = e.res;
-        request = std::move(e.request);
-        return *this;
-    }
+    constexpr async_event(details::request_ring *ring, uint64_t ticket) : ring(ring), ticket(ticket), res(-1) {}
 
-    [[nodiscard]] auto get_request() const -> MPI_Request * { return request.get(); };
+    // Pointer to the underlying request, nullptr if the handle is stale
+    [[nodiscard]] auto get_request() const -> MPI_Request * { return ring ? ring->get(ticket) : nullptr; };
 
+    [[nodiscard]] bool stale() const { return get_request() == nullptr; }
 
-    [[nodiscard]] std::unique_ptr<MPI_Status> wait() const {
-        auto mpi_status = std::make_unique<MPI_Status>();
-        MPI_Wait(request.get(), mpi_status.get());
+    // A stale handle yields the empty status MPI_Wait gives for an inactive
+    // request (MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_SUCCESS), as before handles existed
+    [[nodiscard]] MPI_Status wait() const {
+        MPI_Status mpi_status;
+        MPI_Request inactive = MPI_REQUEST_NULL;
+        auto *request = get_request();
+        MPI_Wait(request ? request : &inactive, &mpi_status);
         return mpi_status;
     }
 
     template<bool status>
         requires(status == empi::details::no_status)
     void wait() const {
-        MPI_Wait(request.get(), MPI_STATUS_IGNORE);
+        if(auto *request = get_request()) MPI_Wait(request, MPI_STATUS_IGNORE);
     }
 
+    // Runs f on this thread once the request completes, from progress() or a
+    // continuation wait(). If f returns an async_event, the returned
+    // continuation also waits for it, so chains of dependent operations compose:
+    //
+    //     mgh.Irecv(buf, src, n).then([&] { unpack(buf); return mgh.Isend(out, dst, n); }).then(...)
+    //
+    // Must be called by the thread that posted the request.
+    template<typename F>
+    continuation then(F &&f) const;
+
+    details::request_ring *ring;
+    uint64_t ticket;
     int res;
-    std::unique_ptr<MPI_Request> request;
 };
 
-using async_event_p = std::shared_ptr<empi::async_event>;
+static_assert(std::is_trivially_copyable_v<async_event>);
+
+namespace details {
+
+// Shared by a continuation handle and the closure that completes it
+struct continuation_state {
+    void complete() {
+        done = true;
+        for(auto &f : std::exchange(next, {})) f();
+    }
+
+    bool done = false;
+    std::vector<std::function<void()>> next; // Registered by continuation::then before completion
+};
+
+struct pending_continuation {
+    async_event event;
+    std::function<void()> run;
+};
+
+// Continuations of this thread waiting for their event, in registration order
+inline std::vector<pending_continuation> &pending_continuations() {
+    thread_local std::vector<pending_continuation> pending;
+    return pending;
+}
+
+inline void when_complete(const async_event &event, std::function<void()> run) {
+    pending_continuations().push_back({event, std::move(run)});
+}
+
+// Runs f, then completes state right away or, when f returned an event, once that event completes
+template<typename F>
+std::function<void()> chain(std::shared_ptr<continuation_state> state, F &&f) {
+    return [state = std::move(state), f = std::forward<F>(f)]() mutable {
+        if constexpr(std::is_same_v<std::invoke_result_t<F &>, async_event>) {
+            const async_event event = f();
+            when_complete(event, [state] { state->complete(); });
+        } else {
+            f();
+            state->complete();
+        }
+    };
+}
+
+} // namespace details
+
+// Runs the continuations of the calling thread whose event completed and returns
+// how many ran. The active requests are tested with a single MPI_Testsome; a
+// request completed elsewhere (wait, waitall) or already recycled counts as complete.
+// Continuations registered while running wait for the next call.
+inline int progress() {
+    auto &pending = details::pending_continuations();
+    if(pending.empty()) return 0;
+
+    thread_local std::vector<MPI_Request *> slots;
+    thread_local std::vector<MPI_Request> requests;
+    thread_local std::vector<int> indices;
+    slots.clear();
+    for(const auto &p : pending)
+        if(auto *request = p.event.get_request(); request && *request != MPI_REQUEST_NULL) slots.push_back(request);
+    // then() twice on the same event must not put a request twice in the array
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+    if(!slots.empty()) {
+        requests.resize(slots.size());
+        indices.resize(slots.size());
+        std::transform(slots.begin(), slots.end(), requests.begin(), [](MPI_Request *r) { return *r; });
+        int completed;
+        MPI_Testsome(static_cast<int>(requests.size()), requests.data(), &completed, indices.data(),
+            MPI_STATUSES_IGNORE);
+        // Same as the ring does for its own slots, also for copies of persistent requests
+        if(completed != MPI_UNDEFINED)
+            for(int i = 0; i < completed; i++) *slots[indices[i]] = MPI_REQUEST_NULL;
+    }
+
+    std::vector<std::function<void()>> ready;
+    const auto waiting = std::stable_partition(pending.begin(), pending.end(), [](const auto &p) {
+        auto *request = p.event.get_request();
+        return request && *request != MPI_REQUEST_NULL;
+    });
+    for(auto it = waiting; it != pending.end(); ++it) ready.push_back(std::move(it->run));
+    pending.erase(waiting, pending.end());
+    for(auto &f : ready) f();
+    return static_cast<int>(ready.size());
+}
+
+// Completion of a then() callable, and of the event it returned if any
+class continuation {
+  public:
+    continuation() : state(std::make_shared<details::continuation_state>()) {}
+
+    // Runs f after this continuation completed, with the same rules as async_event::then
+    template<typename F>
+    continuation then(F &&f) const {
+        continuation next;
+        auto run = details::chain(next.state, std::forward<F>(f));
+        if(state->done)
+            details::when_complete(async_event{}, std::move(run));
+        else
+            state->next.push_back(std::move(run));
+        return next;
+    }
+
+    [[nodiscard]] bool done() const { return state->done; }
+
+    // Calls progress() until completed
+    void wait() const {
+        while(!state->done) progress();
+    }
+
+  private:
+    friend struct async_event;
+
+    std::shared_ptr<details::continuation_state> state;
+};
+
+template<typename F>
+continuation async_event::then(F &&f) const {
+    continuation next;
+    details::when_complete(*this, details::chain(next.state, std::forward<F>(f)));
+    return next;
+}
 
 } // namespace empi
 
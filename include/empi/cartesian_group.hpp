@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_CARTESIAN_GROUP_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_CARTESIAN_GROUP_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mpi.h>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <empi/message_group.hpp>
+#include <empi/request_pool.hpp>
+
+namespace empi {
+
+// Peers returned by CartesianMessageGroup::shift: data moving by +disp along a
+// dimension is received from source and sent to dest. Either is MPI_PROC_NULL
+// past the border of a non periodic dimension, and send/recv with it are no-ops.
+struct cart_shift {
+    int source;
+    int dest;
+};
+
+// MessageGroup over a cartesian communicator built with MPI_Cart_create.
+// Zero entries in dims are filled in by MPI_Dims_create; the grid may be smaller
+// than parent, whose extra processes cannot create the group. With reorder the MPI
+// library may renumber the processes to map the grid onto the machine, so
+// rank(), coords() and every peer refer to the cartesian communicator.
+// prec() and next() are the neighbors along dimension 0.
+template<typename Trace = no_trace>
+class BasicCartesianMessageGroup : public BasicMessageGroup<Trace> {
+    using base = BasicMessageGroup<Trace>;
+    using base::_next;
+    using base::_prec;
+    using base::_rank;
+    using base::_size;
+    using base::comm;
+
+  public:
+    BasicCartesianMessageGroup(MPI_Comm parent, std::vector<int> dims, const std::vector<int> &periods,
+        bool reorder = false, size_t pool_size = request_pool::default_pool_size)
+        : base(create_cart(parent, dims, periods, reorder), pool_size), _dims(std::move(dims)), _periods(periods) {
+        MPI_Comm_rank(comm, &_rank);
+        MPI_Comm_size(comm, &_size);
+        _coords.resize(_dims.size());
+        MPI_Cart_coords(comm, _rank, static_cast<int>(_dims.size()), _coords.data());
+        const auto ring = shift(0, 1);
+        _prec = ring.source;
+        _next = ring.dest;
+    }
+
+    BasicCartesianMessageGroup(const BasicCartesianMessageGroup &) = delete;
+    BasicCartesianMessageGroup &operator=(const BasicCartesianMessageGroup &) = delete;
+
+    ~BasicCartesianMessageGroup() override {
+        this->wait_all();
+        MPI_Comm_free(&comm);
+    }
+
+    [[nodiscard]] int ndims() const { return static_cast<int>(_dims.size()); }
+
+    [[nodiscard]] const std::vector<int> &dims() const { return _dims; }
+
+    [[nodiscard]] const std::vector<int> &periods() const { return _periods; }
+
+    // Coordinates of this process in the grid
+    [[nodiscard]] const std::vector<int> &coords() const { return _coords; }
+
+    [[nodiscard]] std::vector<int> coords(int rank) const {
+        std::vector<int> c(_dims.size());
+        MPI_Cart_coords(comm, rank, ndims(), c.data());
+        return c;
+    }
+
+    // Rank at coords; periodic dimensions wrap, out of range coordinates
+    // along a non periodic one give MPI_PROC_NULL
+    [[nodiscard]] int rank_of(const std::vector<int> &coords) const {
+        for(int d = 0; d < ndims(); d++)
+            if(!_periods[d] && (coords[d] < 0 || coords[d] >= _dims[d])) return MPI_PROC_NULL;
+        int rank;
+        MPI_Cart_rank(comm, coords.data(), &rank);
+        return rank;
+    }
+
+    [[nodiscard]] cart_shift shift(int dim, int disp) const {
+        cart_shift peers{};
+        MPI_Cart_shift(comm, dim, disp, &peers.source, &peers.dest);
+        return peers;
+    }
+
+  private:
+    static MPI_Comm create_cart(
+        MPI_Comm parent, std::vector<int> &dims, const std::vector<int> &periods, bool reorder) {
+        if(dims.size() != periods.size()) throw std::invalid_argument("dims and periods must have the same length");
+        if(std::any_of(dims.begin(), dims.end(), [](int d) { return d < 0; }))
+            throw std::invalid_argument("dims must not be negative");
+        int size;
+        MPI_Comm_size(parent, &size);
+        // MPI_Dims_create and MPI_Cart_create fail through the error handler, not with MPI_COMM_NULL
+        if(std::find(dims.begin(), dims.end(), 0) != dims.end()) {
+            const int fixed = std::accumulate(dims.begin(), dims.end(), 1, [](int p, int d) { return d ? p * d : p; });
+            if(size % fixed != 0)
+                throw std::invalid_argument("the fixed dims do not divide the number of processes");
+            MPI_Dims_create(size, static_cast<int>(dims.size()), dims.data());
+        }
+        if(std::accumulate(dims.begin(), dims.end(), 1, std::multiplies<>()) > size)
+            throw std::invalid_argument("the cartesian grid has more processes than the communicator");
+        MPI_Comm cart;
+        MPI_Cart_create(parent, static_cast<int>(dims.size()), dims.data(), periods.data(), reorder, &cart);
+        // Processes left out of a grid smaller than parent get MPI_COMM_NULL
+        if(cart == MPI_COMM_NULL) throw std::runtime_error("Process is not part of the cartesian grid");
+        return cart;
+    }
+
+    std::vector<int> _dims;
+    std::vector<int> _periods;
+    std::vector<int> _coords;
+};
+
+using CartesianMessageGroup = BasicCartesianMessageGroup<>;
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_CARTESIAN_GROUP_HPP_
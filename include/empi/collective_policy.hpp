@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_COLLECTIVE_POLICY_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_COLLECTIVE_POLICY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <utility>
+#include <vector>
+
+#include <empi/collectives.hpp>
+#include <empi/defines.hpp>
+#include <empi/hierarchy.hpp>
+#include <empi/request_pool.hpp>
+#include <empi/tuning.hpp>
+
+namespace empi::details {
+
+// Algorithm selection of a MessageGroup: the threshold table, a private
+// communicator for the EMPI algorithms (their messages never match user
+// receives) and the node hierarchy, built the first time it is needed.
+// Sizes with no row in the table come from the Context tuning, if any: the
+// loaded tuning table, else the online tuning, else flat.
+// Every process must select the same algorithm, which holds as long as the
+// table is the same everywhere since Bcast/Allreduce sizes match; the online
+// tuning agrees on the winner with an allreduce of the timings.
+class collective_policy {
+  public:
+    collective_policy(MPI_Comm parent, std::shared_ptr<request_pool> pool) : pool(std::move(pool)) {
+        MPI_Comm_dup(parent, &comm);
+        MPI_Comm_size(comm, &comm_size);
+    }
+
+    collective_policy(const collective_policy &) = delete;
+    collective_policy &operator=(const collective_policy &) = delete;
+
+    ~collective_policy() {
+        hierarchy.reset();
+        MPI_Comm_free(&comm);
+    }
+
+    // Collective: the tuning key needs the largest number of ranks per node
+    void set_tuning(std::shared_ptr<tuning> t) {
+        MPI_Comm node;
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+        MPI_Comm_size(node, &ranks_per_node);
+        MPI_Comm_free(&node);
+        MPI_Allreduce(MPI_IN_PLACE, &ranks_per_node, 1, MPI_INT, MPI_MAX, comm);
+        tuner = std::move(t);
+        tuned.clear();
+        trials.clear();
+    }
+
+    // Algorithm picked by the table or the tuning
+    int bcast(void *data, int count, MPI_Datatype type, int root) {
+        return dispatch(mpi_function::bcast, static_cast<size_t>(count) * extent_of(type), true,
+            [&](const threshold &algorithm) { return bcast(data, count, type, root, algorithm.mode, algorithm.segment); });
+    }
+
+    int allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, MPI_Op op) {
+        int commutative;
+        MPI_Op_commutative(op, &commutative);
+        return dispatch(mpi_function::allreduce, static_cast<size_t>(count) * extent_of(type), commutative,
+            [&](const threshold &algorithm) {
+                return allreduce(sendbuf, recvbuf, count, type, op, algorithm.mode, algorithm.segment);
+            });
+    }
+
+    int bcast(void *data, int count, MPI_Datatype type, int root, collective_mode mode, size_t segment) {
+        switch(mode) {
+        case collective_mode::hierarchical: return nodes().bcast(data, count, type, root);
+        case collective_mode::chain: return bcast_pipelined(data, count, type, root, comm, *pool, segment, false);
+        case collective_mode::binary_tree: return bcast_pipelined(data, count, type, root, comm, *pool, segment, true);
+        default: return EMPI_BCAST(data, count, type, root, comm);
+        }
+    }
+
+    int allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, MPI_Op op, collective_mode mode,
+        size_t segment) {
+        int commutative;
+        MPI_Op_commutative(op, &commutative);
+        if(commutative && mode == collective_mode::hierarchical)
+            return nodes().allreduce(sendbuf, recvbuf, count, type, op);
+        if(commutative && mode == collective_mode::ring)
+            return allreduce_ring(sendbuf, recvbuf, count, type, op, comm, *pool, segment);
+        return EMPI_ALLREDUCE(sendbuf, recvbuf, count, type, op, comm);
+    }
+
+    threshold_table table;
+
+  private:
+    // Best time of every candidate so far, one entry per key being tuned
+    struct trial {
+        std::vector<double> best;
+        int calls = 0;
+    };
+
+    // tunable is false for non commutative reductions, which only run flat
+    template<typename F>
+    int dispatch(mpi_function f, size_t bytes, bool tunable, F &&run) {
+        const auto &rows = f == mpi_function::allreduce ? table.allreduce : table.bcast;
+        if(!rows.empty() || !tuner || !tunable) return run(threshold_table::select(rows, bytes));
+
+        const tuning_key key{f, comm_size, ranks_per_node, tuning_key::bucket(bytes)};
+        if(const auto it = tuned.find(key); it != tuned.end()) return run(it->second);
+        if(const auto found = tuner->table.find(key)) return run(tuned[key] = *found);
+        if(!tuner->options.online) return run(threshold{0, collective_mode::flat});
+
+        // Online: every candidate runs for trials calls, the fastest is locked in
+        const auto candidates = candidates_of(f);
+        auto &state = trials[key];
+        if(state.best.empty()) state.best.assign(candidates.size(), std::numeric_limits<double>::max());
+        const size_t candidate = state.calls / tuner->options.trials;
+        const double start = MPI_Wtime();
+        const int res = run(candidates[candidate]);
+        state.best[candidate] = std::min(state.best[candidate], MPI_Wtime() - start);
+
+        if(++state.calls == static_cast<int>(candidates.size()) * tuner->options.trials) {
+            // A collective takes as long as its slowest process
+            MPI_Allreduce(MPI_IN_PLACE, state.best.data(), static_cast<int>(state.best.size()), MPI_DOUBLE, MPI_MAX,
+                comm);
+            const auto winner = std::min_element(state.best.begin(), state.best.end()) - state.best.begin();
+            tuned[key] = candidates[winner];
+            tuner->learn(key, candidates[winner]);
+            trials.erase(key);
+        }
+        return res;
+    }
+
+    [[nodiscard]] std::vector<threshold> candidates_of(mpi_function f) const {
+        std::vector<threshold> candidates{{0, collective_mode::flat}};
+        if(comm_size == 1) return candidates;
+        if(f == mpi_function::bcast) {
+            candidates.push_back({0, collective_mode::chain});
+            candidates.push_back({0, collective_mode::binary_tree});
+        } else
+            candidates.push_back({0, collective_mode::ring});
+        if(ranks_per_node > 1) candidates.push_back({0, collective_mode::hierarchical});
+        return candidates;
+    }
+
+    node_hierarchy &nodes() {
+        if(!hierarchy) hierarchy = std::make_unique<node_hierarchy>(comm);
+        return *hierarchy;
+    }
+
+    std::shared_ptr<request_pool> pool;
+    MPI_Comm comm = MPI_COMM_NULL;
+    int comm_size;
+    std::unique_ptr<node_hierarchy> hierarchy;
+    std::shared_ptr<tuning> tuner;
+    int ranks_per_node = 1;
+    std::map<tuning_key, threshold> tuned; // Locked in, from the tuning table or online
+    std::map<tuning_key, trial> trials;
+};
+
+} // namespace empi::details
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_COLLECTIVE_POLICY_HPP_
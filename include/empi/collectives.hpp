@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_COLLECTIVES_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_COLLECTIVES_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <mpi.h>
+#include <utility>
+#include <vector>
+
+#include <empi/async_event.hpp>
+#include <empi/defines.hpp>
+#include <empi/request_pool.hpp>
+
+namespace empi {
+
+// Algorithms for Bcast and Allreduce. flat is the MPI library collective;
+// chain and binary_tree only apply to Bcast, ring only to Allreduce (other
+// combinations run flat).
+enum class collective_mode { flat, hierarchical, chain, binary_tree, ring };
+
+constexpr size_t default_segment_bytes = 64 * 1024;
+
+// Messages of at most max_bytes use mode; the pipelined algorithms split them
+// in segments of segment bytes
+struct threshold {
+    size_t max_bytes;
+    collective_mode mode;
+    size_t segment = default_segment_bytes;
+};
+
+// Per collective choice of the algorithm by message size.
+// Rows are sorted by max_bytes, sizes past the last row keep its mode and an
+// empty table is always flat.
+struct threshold_table {
+    std::vector<threshold> allreduce;
+    std::vector<threshold> bcast;
+
+    [[nodiscard]] static threshold select(const std::vector<threshold> &rows, size_t bytes) {
+        if(rows.empty()) return {0, collective_mode::flat};
+        for(const auto &row : rows)
+            if(bytes <= row.max_bytes) return row;
+        return rows.back();
+    }
+
+    // Same mode for every size of both collectives
+    [[nodiscard]] static threshold_table all(collective_mode mode) { return {{{0, mode}}, {{0, mode}}}; }
+};
+
+namespace details {
+
+inline MPI_Aint extent_of(MPI_Datatype type) {
+    MPI_Aint lb, extent;
+    MPI_Type_get_extent(type, &lb, &extent);
+    return extent;
+}
+
+// At most this many segments per peer are in flight: MPI matches an incoming
+// message by walking the posted receives (and a posted receive by walking the
+// unexpected messages), so posting every segment up front makes matching
+// quadratic in the segments.
+inline constexpr int segment_window = 16;
+
+// Waits for a segment operation, keeping its error in res unless one was seen before
+inline void retire(const async_event &event, int &res) {
+    event.wait<no_status>();
+    if(res == MPI_SUCCESS) res = event.res;
+}
+
+// Pipelined bcast over a chain (rank root+i forwards to root+i+1) or a binary
+// tree rooted at root. Every process keeps a window of segment receives posted
+// and forwards each segment as soon as it arrives, so the links of the
+// chain/tree are busy at the same time.
+inline int bcast_pipelined(void *data, int count, MPI_Datatype type, int root, MPI_Comm comm, request_pool &pool,
+    size_t segment, bool tree) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const int v = (rank - root + size) % size;
+    const int parent = v == 0 ? MPI_PROC_NULL : ((tree ? (v - 1) / 2 : v - 1) + root) % size;
+    std::vector<int> children;
+    for(const int child : tree ? std::vector<int>{2 * v + 1, 2 * v + 2} : std::vector<int>{v + 1})
+        if(child < size) children.push_back((child + root) % size);
+
+    const MPI_Aint extent = extent_of(type);
+    const int seg = std::max(1, static_cast<int>(segment / extent));
+    const int segments = (count + seg - 1) / seg;
+    auto *bytes = static_cast<char *>(data);
+    const auto length = [&](int i) { return std::min(seg, count - i * seg); };
+
+    // The receive of segment i lives in recvs[i % window], its sends in sends[i % window]
+    const int window = std::min(segments, segment_window);
+    std::vector<async_event> recvs(parent == MPI_PROC_NULL ? 0 : window);
+    std::vector<std::vector<async_event>> sends(children.empty() ? 0 : window);
+    const auto post = [&](int i) {
+        auto &event = recvs[i % window];
+        event = pool.get_req();
+        event.res = MPI_Irecv(bytes + i * seg * extent, length(i), type, parent, 0, comm, event.get_request());
+    };
+    for(int i = 0; i < static_cast<int>(recvs.size()); i++) post(i);
+
+    int res = MPI_SUCCESS;
+    for(int i = 0; i < segments; i++) {
+        if(!recvs.empty()) {
+            retire(recvs[i % window], res);
+            if(i + window < segments) post(i + window);
+        }
+        if(sends.empty()) continue;
+        auto &slot = sends[i % window];
+        for(const auto &event : slot) retire(event, res);
+        slot.clear();
+        for(const int child : children) {
+            auto event = pool.get_req();
+            event.res = MPI_Isend(bytes + i * seg * extent, length(i), type, child, 0, comm, event.get_request());
+            slot.push_back(event);
+        }
+    }
+    for(const auto &slot : sends)
+        for(const auto &event : slot) retire(event, res);
+    return res;
+}
+
+// Ring allreduce: reduce-scatter in size - 1 steps, each process ending with one
+// fully reduced chunk, then allgather of the chunks in size - 1 more steps.
+// Each step moves a chunk to the right neighbor in segments, the reduction of a
+// segment overlaps the transfer of the next ones, whose receives are posted a
+// window ahead. Only for commutative op.
+inline int allreduce_ring(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, MPI_Op op, MPI_Comm comm,
+    request_pool &pool, size_t segment) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    const MPI_Aint extent = extent_of(type);
+    auto *result = static_cast<char *>(recvbuf);
+    if(sendbuf != MPI_IN_PLACE) std::memcpy(result, sendbuf, static_cast<size_t>(count) * extent);
+    if(size == 1) return MPI_SUCCESS;
+
+    const int left = (rank - 1 + size) % size;
+    const int right = (rank + 1) % size;
+    const auto first = [&](int chunk) { return static_cast<int>(static_cast<long>(count) * chunk / size); };
+    const auto length = [&](int chunk) { return first(chunk + 1) - first(chunk); };
+    const int seg = std::max(1, static_cast<int>(segment / extent));
+    std::vector<char> incoming(static_cast<size_t>(count / size + 1) * extent);
+
+    int res = MPI_SUCCESS;
+    // Sends chunk out, receives chunk in into dest segment by segment, calling on_segment after each arrives
+    const auto step = [&](int out, int in, char *dest, auto &&on_segment) {
+        // Segment i of the chunk received lives in recvs[i % window], of the one sent in sends[i % window]
+        const int in_segments = (length(in) + seg - 1) / seg;
+        const int out_segments = (length(out) + seg - 1) / seg;
+        const int window = std::min(std::max(in_segments, out_segments), segment_window);
+        std::vector<async_event> recvs(window), sends(window);
+        const auto post = [&](int i) {
+            auto &event = recvs[i % window];
+            event = pool.get_req();
+            event.res = MPI_Irecv(dest + i * seg * extent, std::min(seg, length(in) - i * seg), type, left, 0, comm,
+                event.get_request());
+        };
+        for(int i = 0; i < std::min(in_segments, window); i++) post(i);
+        for(int i = 0; i < std::max(in_segments, out_segments); i++) {
+            if(i < out_segments) {
+                auto &event = sends[i % window];
+                if(i >= window) retire(event, res);
+                event = pool.get_req();
+                event.res = MPI_Isend(result + (first(out) + i * seg) * extent, std::min(seg, length(out) - i * seg),
+                    type, right, 0, comm, event.get_request());
+            }
+            if(i < in_segments) {
+                retire(recvs[i % window], res);
+                if(i + window < in_segments) post(i + window);
+                on_segment(i * seg, std::min(seg, length(in) - i * seg));
+            }
+        }
+        for(int i = std::max(0, out_segments - window); i < out_segments; i++) retire(sends[i % window], res);
+    };
+
+    for(int k = 0; k < size - 1; k++) {
+        const int out = (rank - k + size) % size;
+        const int in = (rank - k - 1 + size) % size;
+        step(out, in, incoming.data(), [&](int off, int len) {
+            MPI_Reduce_local(incoming.data() + off * extent, result + (first(in) + off) * extent, len, type, op);
+        });
+    }
+    for(int k = 0; k < size - 1; k++) {
+        const int out = (rank + 1 - k + size) % size;
+        const int in = (rank - k + size) % size;
+        step(out, in, result + first(in) * extent, [](int, int) {});
+    }
+    return res;
+}
+
+} // namespace details
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_COLLECTIVES_HPP_
@@ -6,6 +6,7 @@
 #define EMPI_PROJECT_CONTEXT_HPP
 
 #include <cstddef>
+#include <cstdlib>
 #include <mpi.h>
 #include <memory>
 
@@ -14,31 +15,88 @@
 #include <empi/type_traits.hpp>
 #include <functional>
 #include "message_group.hpp"
+#include <empi/cartesian_group.hpp>
+#include <empi/graph_group.hpp>
+#include <empi/progress.hpp>
+#include <empi/trace.hpp>
+#include <empi/tuning.hpp>
+#include <stdexcept>
+#include <vector>
 
 namespace empi{
 
     class Context{
 
     public:
-        Context(int* argc, char*** argv){
+        // With a tuning table (tuning.file or EMPI_TUNING_FILE) or online tuning, the groups
+        // created by this context pick their Bcast/Allreduce algorithms, see tuning_options
+        Context(int* argc, char*** argv, tuning_options tuning = {}){
             MPI_Init_thread(argc, argv, MPI_THREAD_MULTIPLE, &thread_support);  
+            if(const char* file = std::getenv("EMPI_TUNING_FILE"); tuning.file.empty() && file)
+                tuning.file = file;
+            if(!tuning.file.empty() || tuning.online)
+                _tuning = std::make_shared<details::tuning>(std::move(tuning));
         }
 
         Context(const Context& c) = delete;
         Context(Context&& c) = default;
 
         ~Context(){
+            stop_progress();
             MPI_Barrier(MPI_COMM_WORLD);
+            // Also dumps the recorded traces, if any (details::trace_registry)
             MPI_Finalize();
         }
 
-		std::unique_ptr<MessageGroup> create_message_group(MPI_Comm comm, size_t pool_size = request_pool::default_pool_size) {
-		return std::make_unique<MessageGroup>(comm);
+		// create_message_group<recording_trace>(comm) records the calls of the group, see trace.hpp
+		template<typename Trace = no_trace>
+		std::unique_ptr<BasicMessageGroup<Trace>> create_message_group(MPI_Comm comm, size_t pool_size = request_pool::default_pool_size) {
+		return attach(std::make_unique<BasicMessageGroup<Trace>>(comm, pool_size));
 	  }
 
+		// sources/destinations are ranks of comm, see GraphMessageGroup
+		template<typename Trace = no_trace>
+		std::unique_ptr<BasicGraphMessageGroup<Trace>> create_graph_group(MPI_Comm comm, const std::vector<int>& sources, const std::vector<int>& destinations,
+			bool reorder = false, size_t pool_size = request_pool::default_pool_size) {
+		return attach(std::make_unique<BasicGraphMessageGroup<Trace>>(comm, sources, destinations, reorder, pool_size));
+	  }
+
+		// Zero entries in dims are chosen by MPI_Dims_create, see CartesianMessageGroup
+		template<typename Trace = no_trace>
+		std::unique_ptr<BasicCartesianMessageGroup<Trace>> create_cartesian_group(const std::vector<int>& dims, const std::vector<int>& periods,
+			bool reorder = false, MPI_Comm comm = MPI_COMM_WORLD, size_t pool_size = request_pool::default_pool_size) {
+		return attach(std::make_unique<BasicCartesianMessageGroup<Trace>>(comm, dims, periods, reorder, pool_size));
+	  }
+
+		// Loaded table plus the winners of the online tuning so far, e.g. to save() for the next runs
+		tuning_table tuning_results() const {
+		return _tuning ? _tuning->results() : tuning_table{};
+	  }
+
+		// Progress thread for the nonblocking operations of every group of this context,
+		// until stop_progress or the end of the context. Needs MPI_THREAD_MULTIPLE.
+		void start_progress(progress_options options = {}) {
+		if(thread_support < MPI_THREAD_MULTIPLE)
+			throw std::logic_error("start_progress: the MPI library does not support MPI_THREAD_MULTIPLE");
+		if(!_progress) _progress = std::make_unique<details::progress_engine>(options, _progress_signal);
+	  }
+
+		void stop_progress() { _progress.reset(); }
+
 	 private:
+		// Every group shares the context tuning and wakes its progress thread
+		template<typename G>
+		std::unique_ptr<G> attach(std::unique_ptr<G> group) {
+		if(_tuning) group->set_tuning(_tuning);
+		group->set_progress_signal(_progress_signal);
+		return group;
+	  }
+
          int _rank;
          int thread_support;
+         std::shared_ptr<details::tuning> _tuning;
+         std::shared_ptr<details::progress_signal> _progress_signal = std::make_shared<details::progress_signal>();
+         std::unique_ptr<details::progress_engine> _progress;
 	};
 
 
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_COROUTINE_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_COROUTINE_HPP_
+
+#include <algorithm>
+#include <coroutine>
+#include <exception>
+#include <mpi.h>
+#include <utility>
+#include <vector>
+
+#include <empi/async_event.hpp>
+
+namespace empi {
+
+// co_await on an async_event: resumes once the request completes. The
+// coroutine is resumed from progress(), usually by a scheduler.
+struct event_awaiter {
+    // Completed requests do not suspend, the slot is cleared as progress() does
+    bool await_ready() const {
+        MPI_Request *request = event.get_request();
+        if(request == nullptr || *request == MPI_REQUEST_NULL) return true;
+        int flag;
+        MPI_Test(request, &flag, MPI_STATUS_IGNORE);
+        if(flag) *request = MPI_REQUEST_NULL;
+        return flag;
+    }
+
+    void await_suspend(std::coroutine_handle<> coroutine) const {
+        event.then([coroutine] { coroutine.resume(); });
+    }
+
+    [[nodiscard]] int await_resume() const { return event.res; }
+
+    async_event event;
+};
+
+inline event_awaiter operator co_await(async_event event) { return {event}; }
+
+// co_await on a continuation (async_event::then)
+struct continuation_awaiter {
+    bool await_ready() const { return next.done(); }
+
+    void await_suspend(std::coroutine_handle<> coroutine) const {
+        next.then([coroutine] { coroutine.resume(); });
+    }
+
+    void await_resume() const {}
+
+    continuation next;
+};
+
+inline continuation_awaiter operator co_await(continuation next) { return {std::move(next)}; }
+
+// Coroutine returning nothing, lazily started: by a scheduler or by the first
+// coroutine that co_awaits it, which resumes when it returns.
+//
+//     empi::task exchange(Handler &mgh, ...) {
+//         co_await mgh.Irecv(buf, src, n);
+//         ...
+//     }
+class task {
+  public:
+    struct promise_type {
+        task get_return_object() { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // Resume the coroutine awaiting this one, if any
+        auto final_suspend() noexcept {
+            struct final_awaiter {
+                bool await_ready() noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> self) noexcept {
+                    const auto awaiting = self.promise().awaiting;
+                    return awaiting ? awaiting : std::noop_coroutine();
+                }
+
+                void await_resume() noexcept {}
+            };
+            return final_awaiter{};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        std::coroutine_handle<> awaiting;
+        std::exception_ptr exception;
+    };
+
+    task(const task &) = delete;
+    task &operator=(const task &) = delete;
+
+    task(task &&other) noexcept : coroutine(std::exchange(other.coroutine, nullptr)) {}
+
+    task &operator=(task &&other) noexcept {
+        std::swap(coroutine, other.coroutine);
+        return *this;
+    }
+
+    ~task() {
+        if(coroutine) coroutine.destroy();
+    }
+
+    [[nodiscard]] bool done() const { return !coroutine || coroutine.done(); }
+
+    // Rethrows what escaped the coroutine body
+    void result() const {
+        if(coroutine && coroutine.promise().exception) std::rethrow_exception(coroutine.promise().exception);
+    }
+
+    // Awaiting a task starts it and resumes when it finished
+    bool await_ready() const { return done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+        coroutine.promise().awaiting = awaiting;
+        return coroutine;
+    }
+
+    void await_resume() const { result(); }
+
+  private:
+    friend class scheduler;
+
+    explicit task(std::coroutine_handle<promise_type> coroutine) : coroutine(coroutine) {}
+
+    std::coroutine_handle<promise_type> coroutine;
+};
+
+// Single threaded scheduler: starts the spawned tasks and calls progress()
+// until all of them finished, each suspended coroutine is resumed as soon as
+// the MPI_Testsome of progress() completes its request. Nothing blocks, so
+// the exchanges of many tasks interleave on the calling thread.
+class scheduler {
+  public:
+    void spawn(task t) { tasks.push_back(std::move(t)); }
+
+    // Returns when every task finished, rethrowing the first exception that escaped one
+    void run() {
+        for(auto &t : tasks)
+            if(!t.coroutine.done()) t.coroutine.resume();
+        while(!std::all_of(tasks.begin(), tasks.end(), [](const task &t) { return t.done(); })) progress();
+        auto finished = std::exchange(tasks, {});
+        for(const auto &t : finished) t.result();
+    }
+
+  private:
+    std::vector<task> tasks;
+};
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_COROUTINE_HPP_
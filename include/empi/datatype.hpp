@@ -5,18 +5,35 @@
 #ifndef EMPI_PROJECT_INCLUDE_EMPI_DATATYPE_HPP_
 #define EMPI_PROJECT_INCLUDE_EMPI_DATATYPE_HPP_
 
+#include <empi/aggregate.hpp>
 #include <empi/type_traits.hpp>
 #include <memory.h>
 #include <type_traits>
+#include <vector>
 
 namespace empi::details {
 
 static constexpr bool no_status = false;
 
 
+template<typename T>
+MPI_Datatype make_aggregate_type();
+
+// Arithmetic types are mapped below, enums as their underlying type; aggregates
+// get a derived datatype, built and committed on first use and kept for the
+// whole process lifetime.
 template<typename T>
 struct mpi_type_impl {
-    static MPI_Datatype get_type() noexcept { return nullptr; }
+    static MPI_Datatype get_type() noexcept {
+        if constexpr(std::is_enum_v<T>) {
+            return mpi_type_impl<std::underlying_type_t<T>>::get_type();
+        } else if constexpr(reflectable<T>) {
+            static const MPI_Datatype type = make_aggregate_type<T>();
+            return type;
+        } else {
+            return nullptr;
+        }
+    }
 };
 
 #define MAKE_TYPE_CONVERSION(T, base_type)                                                                             \
@@ -31,6 +48,48 @@ MAKE_TYPE_CONVERSION(short, MPI_SHORT)
 MAKE_TYPE_CONVERSION(long, MPI_LONG)
 MAKE_TYPE_CONVERSION(float, MPI_FLOAT)
 MAKE_TYPE_CONVERSION(double, MPI_DOUBLE)
+MAKE_TYPE_CONVERSION(signed char, MPI_SIGNED_CHAR)
+MAKE_TYPE_CONVERSION(unsigned char, MPI_UNSIGNED_CHAR)
+MAKE_TYPE_CONVERSION(unsigned short, MPI_UNSIGNED_SHORT)
+MAKE_TYPE_CONVERSION(unsigned, MPI_UNSIGNED)
+MAKE_TYPE_CONVERSION(unsigned long, MPI_UNSIGNED_LONG)
+MAKE_TYPE_CONVERSION(long long, MPI_LONG_LONG)
+MAKE_TYPE_CONVERSION(unsigned long long, MPI_UNSIGNED_LONG_LONG)
+MAKE_TYPE_CONVERSION(long double, MPI_LONG_DOUBLE)
+MAKE_TYPE_CONVERSION(bool, MPI_CXX_BOOL)
+
+// Without padding the aggregate is sent as sizeof(T) contiguous bytes, which MPI
+// copies without walking a type map. Otherwise every member becomes a block of
+// MPI_Type_create_struct (arrays as one block of their element type) and the
+// extent is resized to sizeof(T), so that counts > 1 follow the array stride.
+template<typename T>
+MPI_Datatype make_aggregate_type() {
+    static_assert(has_sendable_leaves<T>(),
+        "Aggregate members must be arithmetic types, enums, arrays or aggregates of them (no pointers)");
+    MPI_Datatype type;
+    if constexpr(is_packed_v<T>) {
+        MPI_Type_contiguous(static_cast<int>(sizeof(T)), MPI_BYTE, &type);
+    } else {
+        std::vector<int> blocklengths;
+        std::vector<MPI_Aint> displacements;
+        std::vector<MPI_Datatype> types;
+        T t{};
+        for_each_field(t, [&](auto &member) {
+            using M = std::remove_cvref_t<decltype(member)>;
+            using leaf = typename array_traits<M>::type;
+            blocklengths.push_back(static_cast<int>(array_traits<M>::extent));
+            displacements.push_back(reinterpret_cast<const char *>(&member) - reinterpret_cast<const char *>(&t));
+            types.push_back(mpi_type_impl<leaf>::get_type());
+        });
+        MPI_Datatype layout;
+        MPI_Type_create_struct(static_cast<int>(types.size()), blocklengths.data(), displacements.data(), types.data(),
+            &layout);
+        MPI_Type_create_resized(layout, 0, sizeof(T), &type);
+        MPI_Type_free(&layout);
+    }
+    MPI_Type_commit(&type);
+    return type;
+}
 
 template<typename T>
 struct mpi_type {
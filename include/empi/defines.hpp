@@ -6,6 +6,7 @@
 #define INCLUDE_EMPI_DEFINES
 
 #include <empi/config.hpp>
+#include <mpi.h>
 
 #if defined(ENABLE_UNCHECKED_FUNCTION)
 #define EMPI_SEND MPI_USend
@@ -16,6 +17,28 @@
 #define EMPI_BCAST MPI_UBcast
 #define EMPI_IBCAST MPI_IUbcast
 #define EMPI_GATHERV MPI_Gatherv // Not yet implemented
+#define EMPI_REDUCE MPI_Reduce // Not yet implemented
+#define EMPI_SCATTER MPI_Scatter // Not yet implemented
+#define EMPI_SCATTERV MPI_Scatterv // Not yet implemented
+#define EMPI_GATHER MPI_Gather // Not yet implemented
+#define EMPI_ALLGATHER MPI_Allgather // Not yet implemented
+#define EMPI_ALLGATHERV MPI_Allgatherv // Not yet implemented
+#define EMPI_ALLTOALL MPI_Alltoall // Not yet implemented
+#define EMPI_ALLTOALLV MPI_Alltoallv // Not yet implemented
+#define EMPI_REDUCE_SCATTER MPI_Reduce_scatter // Not yet implemented
+#define EMPI_REDUCE_SCATTER_BLOCK MPI_Reduce_scatter_block // Not yet implemented
+#define EMPI_SCAN MPI_Scan // Not yet implemented
+#define EMPI_EXSCAN MPI_Exscan // Not yet implemented
+#define EMPI_SEND_INIT MPI_Send_init // Not yet implemented
+#define EMPI_RECV_INIT MPI_Recv_init // Not yet implemented
+#define EMPI_IALLREDUCE MPI_Iallreduce // Not yet implemented
+#define EMPI_IREDUCE MPI_Ireduce // Not yet implemented
+#define EMPI_IGATHERV MPI_Igatherv // Not yet implemented
+#define EMPI_IALLGATHER MPI_Iallgather // Not yet implemented
+#define EMPI_IALLTOALL MPI_Ialltoall // Not yet implemented
+#define EMPI_IBARRIER MPI_Ibarrier // Not yet implemented
+#define EMPI_NEIGHBOR_ALLTOALLV MPI_Neighbor_alltoallv // Not yet implemented
+#define EMPI_INEIGHBOR_ALLTOALLV MPI_Ineighbor_alltoallv // Not yet implemented
 #define EMPI_CHECKCOMM(comm) MPI_Checkcomm(comm)
 #define EMPI_CHECKTYPE(type) MPI_Checktype(type)
 #else
@@ -27,16 +50,63 @@
 #define EMPI_BCAST MPI_Bcast
 #define EMPI_IBCAST MPI_Ibcast
 #define EMPI_GATHERV MPI_Gatherv
+#define EMPI_REDUCE MPI_Reduce
+#define EMPI_SCATTER MPI_Scatter
+#define EMPI_SCATTERV MPI_Scatterv
+#define EMPI_GATHER MPI_Gather
+#define EMPI_ALLGATHER MPI_Allgather
+#define EMPI_ALLGATHERV MPI_Allgatherv
+#define EMPI_ALLTOALL MPI_Alltoall
+#define EMPI_ALLTOALLV MPI_Alltoallv
+#define EMPI_REDUCE_SCATTER MPI_Reduce_scatter
+#define EMPI_REDUCE_SCATTER_BLOCK MPI_Reduce_scatter_block
+#define EMPI_SCAN MPI_Scan
+#define EMPI_EXSCAN MPI_Exscan
+#define EMPI_SEND_INIT MPI_Send_init
+#define EMPI_RECV_INIT MPI_Recv_init
+#define EMPI_IALLREDUCE MPI_Iallreduce
+#define EMPI_IREDUCE MPI_Ireduce
+#define EMPI_IGATHERV MPI_Igatherv
+#define EMPI_IALLGATHER MPI_Iallgather
+#define EMPI_IALLTOALL MPI_Ialltoall
+#define EMPI_IBARRIER MPI_Ibarrier
+#define EMPI_NEIGHBOR_ALLTOALLV MPI_Neighbor_alltoallv
+#define EMPI_INEIGHBOR_ALLTOALLV MPI_Ineighbor_alltoallv
 #define EMPI_CHECKCOMM(comm) // Disable function
 #define EMPI_CHECKTYPE(type) // Disable function
 #endif
 
+// Persistent collectives: MPI-4, or the MPIX extension shipped by OpenMPI 4.x.
+// Without them persistent collectives replay the nonblocking call on start.
+#if MPI_VERSION >= 4
+#define EMPI_HAS_PERSISTENT_COLLECTIVES 1
+#define EMPI_ALLREDUCE_INIT MPI_Allreduce_init
+#define EMPI_BCAST_INIT MPI_Bcast_init
+#define EMPI_NEIGHBOR_ALLTOALLV_INIT MPI_Neighbor_alltoallv_init
+#else
+#if __has_include(<mpi-ext.h>)
+#include <mpi-ext.h>
+#endif
+#if defined(OMPI_HAVE_MPI_EXT_PCOLLREQ) && OMPI_HAVE_MPI_EXT_PCOLLREQ
+#define EMPI_HAS_PERSISTENT_COLLECTIVES 1
+#define EMPI_ALLREDUCE_INIT MPIX_Allreduce_init
+#define EMPI_BCAST_INIT MPIX_Bcast_init
+#define EMPI_NEIGHBOR_ALLTOALLV_INIT MPIX_Neighbor_alltoallv_init
+#else
+#define EMPI_HAS_PERSISTENT_COLLECTIVES 0
+#endif
+#endif
+
 namespace empi {
 
 constexpr int NOSIZE = 0;
 
 namespace details {
-enum mpi_function { send = 1, isend, recv, irecv, bcast, ibcast, allreduce, gatherv, all };
+enum mpi_function {
+    send = 1, isend, recv, irecv, bcast, ibcast, allreduce, gatherv, reduce, scatter, scatterv, gather, allgather,
+    allgatherv, alltoall, alltoallv, reduce_scatter, scan, exscan, neighbor_alltoallv, barrier, ibarrier, iallreduce,
+    ireduce, igatherv, iallgather, ialltoall, ineighbor_alltoallv, wait, all
+};
 
 template<mpi_function f>
 concept is_send = requires { f == mpi_function::send || f == mpi_function::isend; };
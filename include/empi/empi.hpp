@@ -7,8 +7,25 @@
 
 #include <empi/context.hpp>
 #include <empi/message_group.hpp>
+#include <empi/cartesian_group.hpp>
+#include <empi/graph_group.hpp>
+#include <empi/hierarchy.hpp>
+#include <empi/collectives.hpp>
+#include <empi/collective_policy.hpp>
+#include <empi/tuning.hpp>
+#include <empi/shared_buffer.hpp>
+#include <empi/aggregator.hpp>
 #include <empi/message_grp_hdl.hpp>
 #include <empi/async_event.hpp>
+#include <empi/coroutine.hpp>
+#include <empi/execution.hpp>
+#include <empi/persistent.hpp>
+#include <empi/progress.hpp>
+#include <empi/trace.hpp>
+#include <empi/op.hpp>
 #include <empi/tag.hpp>
+#include <empi/view.hpp>
+#include <empi/window.hpp>
+#include <empi/pack.hpp>
 
 #endif // __EMPI_H__
\ No newline at end of file
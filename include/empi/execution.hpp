@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_EXECUTION_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_EXECUTION_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <empi/async_event.hpp>
+
+// Minimal senders and receivers in the style of std::execution (P2300), enough
+// to compose EMPI operations with on-node work:
+//
+//     auto face = ex::schedule(pool.get_scheduler()) | ex::then([&] { pack(f); })
+//               | ex::continues_on(loop.get_scheduler())
+//               | ex::let_value([&] { return ex::isend(mgh, buf, dest, n, empi::Tag{f}); });
+//     ex::sync_wait(loop, ex::when_all(std::move(face), ex::irecv(mgh, ...) | ex::then(unpack)));
+//
+// A sender declares the values it completes with as value_types (a std::tuple)
+// and connect(receiver) returns an operation state, started once with start().
+// A receiver has set_value(values...) and set_error(std::exception_ptr); there
+// is no stop channel. Operation states must stay in place once started.
+//
+// EMPI operations complete through async_event::then, i.e. from progress() on the
+// thread that posted them: they must be started on the thread running the
+// progress_loop (directly, or after continues_on its scheduler).
+namespace empi::execution {
+
+template<typename S>
+concept sender = requires { typename std::remove_cvref_t<S>::value_types; };
+
+template<typename Sch>
+concept scheduler = requires(const Sch &sch) {
+    { sch.schedule() } -> sender;
+};
+
+namespace details {
+
+template<typename S>
+using values_of = typename std::remove_cvref_t<S>::value_types;
+
+// Values of a then() callable: none if it returns void
+template<typename F, typename Values>
+struct then_values;
+
+template<typename F, typename... Ts>
+struct then_values<F, std::tuple<Ts...>> {
+    using result = std::invoke_result_t<F &, Ts...>;
+    using type = std::conditional_t<std::is_void_v<result>, std::tuple<>, std::tuple<std::decay_t<result>>>;
+};
+
+// Sender returned by a let_value() callable, which gets the stored values
+template<typename F, typename Values>
+struct let_sender;
+
+template<typename F, typename... Ts>
+struct let_sender<F, std::tuple<Ts...>> {
+    using type = std::remove_cvref_t<std::invoke_result_t<F &, Ts &...>>;
+};
+
+// Builds a non movable operation state in place, from the prvalue f returns
+template<typename F>
+struct emplace_from {
+    operator std::invoke_result_t<F>() && { return std::move(f)(); }
+
+    F f;
+};
+
+template<typename F>
+emplace_from(F) -> emplace_from<F>;
+
+// Pipe closure of the adaptors: s | then(f) is then(s, f)
+template<typename F>
+struct adaptor {
+    F apply;
+};
+
+template<typename F>
+adaptor(F) -> adaptor<F>;
+
+} // namespace details
+
+template<sender S, typename F>
+auto operator|(S &&s, details::adaptor<F> a) {
+    return std::move(a.apply)(std::forward<S>(s));
+}
+
+// Operation state of s completing into r, lvalue senders are copied
+template<sender S, typename R>
+auto connect(S &&s, R r) {
+    if constexpr(std::is_lvalue_reference_v<S>)
+        return std::remove_cvref_t<S>(s).connect(std::move(r));
+    else
+        return std::move(s).connect(std::move(r));
+}
+
+// ------------------------- JUST --------------------------
+
+template<typename... Ts>
+struct just_sender {
+    using value_types = std::tuple<Ts...>;
+
+    template<typename R>
+    struct operation {
+        void start() {
+            std::apply([this](Ts &...vs) { r.set_value(std::move(vs)...); }, values);
+        }
+
+        value_types values;
+        R r;
+    };
+
+    template<typename R>
+    operation<R> connect(R r) && {
+        return {std::move(values), std::move(r)};
+    }
+
+    value_types values;
+};
+
+template<typename... Ts>
+just_sender<std::decay_t<Ts>...> just(Ts &&...vs) {
+    return {std::tuple<std::decay_t<Ts>...>(std::forward<Ts>(vs)...)};
+}
+
+// ------------------------- THEN --------------------------
+
+// Calls f with the values of s and completes with its result, an exception
+// thrown by f completes with set_error
+template<sender S, typename F>
+struct then_sender {
+    using value_types = typename details::then_values<F, details::values_of<S>>::type;
+
+    template<typename R>
+    struct receiver {
+        template<typename... Ts>
+        void set_value(Ts &&...vs) {
+            using result = std::invoke_result_t<F &, Ts...>;
+            std::exception_ptr error;
+            if constexpr(std::is_void_v<result>) {
+                try {
+                    std::invoke(f, std::forward<Ts>(vs)...);
+                } catch(...) { error = std::current_exception(); }
+                if(error)
+                    r.set_error(error);
+                else
+                    r.set_value();
+            } else {
+                std::optional<std::decay_t<result>> value;
+                try {
+                    value.emplace(std::invoke(f, std::forward<Ts>(vs)...));
+                } catch(...) { error = std::current_exception(); }
+                if(error)
+                    r.set_error(error);
+                else
+                    r.set_value(std::move(*value));
+            }
+        }
+
+        void set_error(std::exception_ptr error) { r.set_error(error); }
+
+        R r;
+        F f;
+    };
+
+    template<typename R>
+    auto connect(R r) && {
+        return execution::connect(std::move(s), receiver<R>{std::move(r), std::move(f)});
+    }
+
+    S s;
+    F f;
+};
+
+template<sender S, typename F>
+then_sender<std::remove_cvref_t<S>, std::decay_t<F>> then(S &&s, F &&f) {
+    return {std::forward<S>(s), std::forward<F>(f)};
+}
+
+template<typename F>
+auto then(F &&f) {
+    return details::adaptor{[f = std::forward<F>(f)](auto &&s) mutable {
+        return execution::then(std::forward<decltype(s)>(s), std::move(f));
+    }};
+}
+
+// ------------------------- LET_VALUE --------------------------
+
+// Calls f with the values of s and starts the sender it returns, the values
+// stay alive until that sender completes
+template<sender S, typename F>
+struct let_value_sender {
+    using first_values = details::values_of<S>;
+    using next_sender = typename details::let_sender<F, first_values>::type;
+    using value_types = details::values_of<next_sender>;
+
+    template<typename R>
+    class operation {
+        struct first_receiver {
+            template<typename... Ts>
+            void set_value(Ts &&...vs) {
+                op->start_next(std::forward<Ts>(vs)...);
+            }
+
+            void set_error(std::exception_ptr error) { op->r.set_error(error); }
+
+            operation *op;
+        };
+
+        struct next_receiver {
+            template<typename... Ts>
+            void set_value(Ts &&...vs) {
+                op->r.set_value(std::forward<Ts>(vs)...);
+            }
+
+            void set_error(std::exception_ptr error) { op->r.set_error(error); }
+
+            operation *op;
+        };
+
+        using first_operation = decltype(execution::connect(std::declval<S>(), std::declval<first_receiver>()));
+        using next_operation = decltype(execution::connect(std::declval<next_sender>(), std::declval<next_receiver>()));
+
+      public:
+        operation(S &&s, F &&f, R &&r)
+            : f(std::move(f)), r(std::move(r)), first(execution::connect(std::move(s), first_receiver{this})) {}
+
+        operation(const operation &) = delete;
+        operation &operator=(const operation &) = delete;
+
+        void start() { first.start(); }
+
+      private:
+        template<typename... Ts>
+        void start_next(Ts &&...vs) {
+            try {
+                values.emplace(std::forward<Ts>(vs)...);
+                next.reset(new next_operation(execution::connect(std::apply(f, *values), next_receiver{this})));
+            } catch(...) {
+                r.set_error(std::current_exception());
+                return;
+            }
+            next->start();
+        }
+
+        F f;
+        R r;
+        std::optional<first_values> values;
+        std::unique_ptr<next_operation> next;
+        first_operation first;
+    };
+
+    template<typename R>
+    operation<R> connect(R r) && {
+        return operation<R>(std::move(s), std::move(f), std::move(r));
+    }
+
+    S s;
+    F f;
+};
+
+template<sender S, typename F>
+let_value_sender<std::remove_cvref_t<S>, std::decay_t<F>> let_value(S &&s, F &&f) {
+    return {std::forward<S>(s), std::forward<F>(f)};
+}
+
+template<typename F>
+auto let_value(F &&f) {
+    return details::adaptor{[f = std::forward<F>(f)](auto &&s) mutable {
+        return execution::let_value(std::forward<decltype(s)>(s), std::move(f));
+    }};
+}
+
+// ------------------------- CONTINUES_ON --------------------------
+
+// Completes with the values (or error) of s on an execution context of sch
+template<sender S, scheduler Sch>
+struct continues_on_sender {
+    using value_types = details::values_of<S>;
+
+    template<typename R>
+    class operation {
+        struct first_receiver {
+            template<typename... Ts>
+            void set_value(Ts &&...vs) {
+                op->values.emplace(std::forward<Ts>(vs)...);
+                op->hop.start();
+            }
+
+            void set_error(std::exception_ptr error) {
+                op->error = error;
+                op->hop.start();
+            }
+
+            operation *op;
+        };
+
+        struct hop_receiver {
+            void set_value() {
+                if(op->error)
+                    op->r.set_error(op->error);
+                else
+                    std::apply([this](auto &...vs) { op->r.set_value(std::move(vs)...); }, *op->values);
+            }
+
+            void set_error(std::exception_ptr error) { op->r.set_error(error); }
+
+            operation *op;
+        };
+
+        using first_operation = decltype(execution::connect(std::declval<S>(), std::declval<first_receiver>()));
+        using hop_operation =
+            decltype(execution::connect(std::declval<const Sch &>().schedule(), std::declval<hop_receiver>()));
+
+      public:
+        operation(S &&s, const Sch &sch, R &&r)
+            : r(std::move(r)), first(execution::connect(std::move(s), first_receiver{this})),
+              hop(execution::connect(sch.schedule(), hop_receiver{this})) {}
+
+        operation(const operation &) = delete;
+        operation &operator=(const operation &) = delete;
+
+        void start() { first.start(); }
+
+      private:
+        R r;
+        std::optional<value_types> values;
+        std::exception_ptr error;
+        first_operation first;
+        hop_operation hop;
+    };
+
+    template<typename R>
+    operation<R> connect(R r) && {
+        return operation<R>(std::move(s), sch, std::move(r));
+    }
+
+    S s;
+    Sch sch;
+};
+
+template<sender S, scheduler Sch>
+continues_on_sender<std::remove_cvref_t<S>, Sch> continues_on(S &&s, Sch sch) {
+    return {std::forward<S>(s), std::move(sch)};
+}
+
+template<scheduler Sch>
+auto continues_on(Sch sch) {
+    return details::adaptor{[sch](auto &&s) { return execution::continues_on(std::forward<decltype(s)>(s), sch); }};
+}
+
+// ------------------------- WHEN_ALL --------------------------
+
+// Starts every sender and completes once all of them did, with their values
+// concatenated in argument order. If any failed, the first error is reported
+// after the others completed.
+template<sender... S>
+struct when_all_sender {
+    using value_types = decltype(std::tuple_cat(std::declval<details::values_of<S>>()...));
+
+    template<typename R>
+    class operation {
+        template<size_t I>
+        struct child_receiver {
+            template<typename... Ts>
+            void set_value(Ts &&...vs) {
+                std::get<I>(op->values).emplace(std::forward<Ts>(vs)...);
+                op->arrive();
+            }
+
+            void set_error(std::exception_ptr error) {
+                if(!op->failed.exchange(true)) op->error = error;
+                op->arrive();
+            }
+
+            operation *op;
+        };
+
+        template<size_t I>
+        using child_operation = decltype(execution::connect(
+            std::declval<std::tuple_element_t<I, std::tuple<S...>>>(), std::declval<child_receiver<I>>()));
+
+        template<typename Indices>
+        struct children_of;
+
+        template<size_t... I>
+        struct children_of<std::index_sequence<I...>> {
+            using type = std::tuple<child_operation<I>...>;
+        };
+
+      public:
+        operation(std::tuple<S...> &&senders, R &&r)
+            : operation(std::move(senders), std::move(r), std::index_sequence_for<S...>{}) {}
+
+        operation(const operation &) = delete;
+        operation &operator=(const operation &) = delete;
+
+        void start() {
+            std::apply([](auto &...child) { (child.start(), ...); }, children);
+        }
+
+      private:
+        template<size_t... I>
+        operation(std::tuple<S...> &&senders, R &&r, std::index_sequence<I...>)
+            : r(std::move(r)), children(details::emplace_from{[&] {
+                  return execution::connect(std::move(std::get<I>(senders)), child_receiver<I>{this});
+              }}...) {}
+
+        // Children may complete on different threads, the last one completes the operation
+        void arrive() {
+            if(remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+            if(error) {
+                r.set_error(error);
+                return;
+            }
+            auto all = std::apply([](auto &...v) { return std::tuple_cat(std::move(*v)...); }, values);
+            std::apply([this](auto &...vs) { r.set_value(std::move(vs)...); }, all);
+        }
+
+        R r;
+        std::tuple<std::optional<details::values_of<S>>...> values;
+        std::exception_ptr error;
+        std::atomic<bool> failed{false};
+        std::atomic<size_t> remaining{sizeof...(S)};
+        typename children_of<std::index_sequence_for<S...>>::type children;
+    };
+
+    template<typename R>
+    operation<R> connect(R r) && {
+        return operation<R>(std::move(senders), std::move(r));
+    }
+
+    std::tuple<S...> senders;
+};
+
+template<sender... S>
+when_all_sender<std::remove_cvref_t<S>...> when_all(S &&...s) {
+    return {std::tuple<std::remove_cvref_t<S>...>(std::forward<S>(s)...)};
+}
+
+// ------------------------- SCHEDULERS --------------------------
+
+// Scheduler of an execution context with a post(std::function<void()>) queue
+template<typename Context>
+class context_scheduler {
+  public:
+    struct sender {
+        using value_types = std::tuple<>;
+
+        template<typename R>
+        struct operation {
+            void start() {
+                context->post([this] { r.set_value(); });
+            }
+
+            Context *context;
+            R r;
+        };
+
+        template<typename R>
+        operation<R> connect(R r) && {
+            return {context, std::move(r)};
+        }
+
+        Context *context;
+    };
+
+    explicit context_scheduler(Context *context) : context(context) {}
+
+    [[nodiscard]] sender schedule() const { return {context}; }
+
+    bool operator==(const context_scheduler &) const = default;
+
+  private:
+    Context *context;
+};
+
+template<scheduler Sch>
+auto schedule(const Sch &sch) {
+    return sch.schedule();
+}
+
+// Runs posted work and the continuations of EMPI operations on the thread
+// calling run_until(); that thread must be the one posting the operations.
+// Idle, it polls with progress() while operations are pending and sleeps
+// otherwise.
+class progress_loop {
+  public:
+    using scheduler = context_scheduler<progress_loop>;
+
+    [[nodiscard]] scheduler get_scheduler() { return scheduler(this); }
+
+    void post(std::function<void()> work) {
+        {
+            std::lock_guard lock(mutex);
+            queue.push_back(std::move(work));
+        }
+        ready.notify_one();
+    }
+
+    // Returns once done is set, by work running on this thread
+    void run_until(const bool &done) {
+        std::deque<std::function<void()>> work;
+        while(!done) {
+            {
+                std::lock_guard lock(mutex);
+                work.swap(queue);
+            }
+            for(auto &w : work) w();
+            const bool ran = !work.empty();
+            work.clear();
+            if(progress() > 0 || ran) continue;
+            if(!empi::details::pending_continuations().empty()) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock lock(mutex);
+            ready.wait(lock, [this, &done] { return done || !queue.empty(); });
+        }
+    }
+
+  private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::function<void()>> queue;
+};
+
+// Fixed set of threads for on-node work, they never call MPI
+class thread_pool {
+  public:
+    using scheduler = context_scheduler<thread_pool>;
+
+    explicit thread_pool(unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+        for(unsigned i = 0; i < threads; i++) workers.emplace_back([this] { work(); });
+    }
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    // Runs the work already posted, then joins
+    ~thread_pool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for(auto &w : workers) w.join();
+    }
+
+    [[nodiscard]] scheduler get_scheduler() { return scheduler(this); }
+
+    void post(std::function<void()> work) {
+        {
+            std::lock_guard lock(mutex);
+            queue.push_back(std::move(work));
+        }
+        ready.notify_one();
+    }
+
+  private:
+    void work() {
+        for(;;) {
+            std::function<void()> next;
+            {
+                std::unique_lock lock(mutex);
+                ready.wait(lock, [this] { return stopping || !queue.empty(); });
+                if(queue.empty()) return;
+                next = std::move(queue.front());
+                queue.pop_front();
+            }
+            next();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::function<void()>> queue;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
+
+// ------------------------- EMPI OPERATIONS --------------------------
+
+// Calls post, which starts an EMPI operation and returns its async_event, and
+// completes with the operation's error code when the request completes
+template<typename F>
+struct event_sender {
+    using value_types = std::tuple<int>;
+
+    template<typename R>
+    struct operation {
+        void start() {
+            try {
+                event = post();
+            } catch(...) {
+                r.set_error(std::current_exception());
+                return;
+            }
+            event.then([this] { r.set_value(event.res); });
+        }
+
+        F post;
+        R r;
+        async_event event{};
+    };
+
+    template<typename R>
+    operation<R> connect(R r) && {
+        return {std::move(post), std::move(r)};
+    }
+
+    F post;
+};
+
+template<typename F>
+event_sender<std::decay_t<F>> from_event(F &&post) {
+    return {std::forward<F>(post)};
+}
+
+// mgh.Isend(args...) as a sender. Lvalue arguments (the buffers) are kept by
+// reference and must live until the sender completes.
+template<typename H, typename... Args>
+auto isend(H &mgh, Args &&...args) {
+    return from_event([&mgh, args = std::tuple<Args...>(std::forward<Args>(args)...)]() mutable {
+        return std::apply([&mgh](auto &&...a) { return mgh.Isend(std::forward<decltype(a)>(a)...); }, args);
+    });
+}
+
+// mgh.Irecv(args...) as a sender, same rules as isend
+template<typename H, typename... Args>
+auto irecv(H &mgh, Args &&...args) {
+    return from_event([&mgh, args = std::tuple<Args...>(std::forward<Args>(args)...)]() mutable {
+        return std::apply([&mgh](auto &&...a) { return mgh.Irecv(std::forward<decltype(a)>(a)...); }, args);
+    });
+}
+
+// ------------------------- SYNC_WAIT --------------------------
+
+namespace details {
+
+template<typename Values>
+struct sync_wait_state {
+    std::optional<Values> result;
+    std::exception_ptr error;
+    bool done = false;
+};
+
+// Completion is posted to the loop, so done is only touched by its thread
+template<typename Values>
+struct sync_wait_receiver {
+    template<typename... Ts>
+    void set_value(Ts &&...vs) {
+        state->result.emplace(std::forward<Ts>(vs)...);
+        loop->post([state = state] { state->done = true; });
+    }
+
+    void set_error(std::exception_ptr error) {
+        state->error = error;
+        loop->post([state = state] { state->done = true; });
+    }
+
+    sync_wait_state<Values> *state;
+    progress_loop *loop;
+};
+
+} // namespace details
+
+// Starts s and runs loop on the calling thread until s completes, returning its
+// values or rethrowing its error
+template<sender S>
+details::values_of<S> sync_wait(progress_loop &loop, S &&s) {
+    using values = details::values_of<S>;
+    details::sync_wait_state<values> state;
+    auto op = execution::connect(std::forward<S>(s), details::sync_wait_receiver<values>{&state, &loop});
+    op.start();
+    loop.run_until(state.done);
+    if(state.error) std::rethrow_exception(state.error);
+    return std::move(*state.result);
+}
+
+template<sender S>
+details::values_of<S> sync_wait(S &&s) {
+    progress_loop loop;
+    return execution::sync_wait(loop, std::forward<S>(s));
+}
+
+} // namespace empi::execution
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_EXECUTION_HPP_
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_GRAPH_GROUP_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_GRAPH_GROUP_HPP_
+
+#include <memory>
+#include <mpi.h>
+#include <vector>
+
+#include <empi/message_group.hpp>
+#include <empi/request_pool.hpp>
+
+namespace empi {
+
+// MessageGroup over a distributed graph communicator built with
+// MPI_Dist_graph_create_adjacent. Every process lists the ranks it receives
+// from (sources) and sends to (destinations); neighbor collectives then
+// exchange one block per neighbor in a single call, in the order of these lists.
+// Ranks passed in are ranks of the parent communicator; sources() and
+// destinations() return them as ranks of the graph communicator.
+template<typename Trace = no_trace>
+class BasicGraphMessageGroup : public BasicMessageGroup<Trace> {
+    using base = BasicMessageGroup<Trace>;
+    using base::_next;
+    using base::_prec;
+    using base::_rank;
+    using base::_size;
+    using base::comm;
+
+  public:
+    BasicGraphMessageGroup(MPI_Comm parent, const std::vector<int> &sources, const std::vector<int> &destinations,
+        bool reorder = false, size_t pool_size = request_pool::default_pool_size)
+        : base(create_graph(parent, sources, destinations, reorder), pool_size) {
+        MPI_Comm_rank(comm, &_rank);
+        MPI_Comm_size(comm, &_size);
+        _next = (_rank + 1) % _size;
+        _prec = _rank == 0 ? (_size - 1) : (_rank - 1);
+        int indegree, outdegree, weighted;
+        MPI_Dist_graph_neighbors_count(comm, &indegree, &outdegree, &weighted);
+        _sources.resize(indegree);
+        _destinations.resize(outdegree);
+        MPI_Dist_graph_neighbors(comm, indegree, _sources.data(), MPI_UNWEIGHTED, outdegree, _destinations.data(),
+            MPI_UNWEIGHTED);
+    }
+
+    BasicGraphMessageGroup(const BasicGraphMessageGroup &) = delete;
+    BasicGraphMessageGroup &operator=(const BasicGraphMessageGroup &) = delete;
+
+    // Pending neighbor collectives must complete before the communicator goes away
+    ~BasicGraphMessageGroup() override {
+        this->wait_all();
+        MPI_Comm_free(&comm);
+    }
+
+    [[nodiscard]] int indegree() const { return static_cast<int>(_sources.size()); }
+
+    [[nodiscard]] int outdegree() const { return static_cast<int>(_destinations.size()); }
+
+    [[nodiscard]] const std::vector<int> &sources() const { return _sources; }
+
+    [[nodiscard]] const std::vector<int> &destinations() const { return _destinations; }
+
+  private:
+    static MPI_Comm create_graph(
+        MPI_Comm parent, const std::vector<int> &sources, const std::vector<int> &destinations, bool reorder) {
+        MPI_Comm graph;
+        MPI_Dist_graph_create_adjacent(parent, static_cast<int>(sources.size()), sources.data(), MPI_UNWEIGHTED,
+            static_cast<int>(destinations.size()), destinations.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, reorder,
+            &graph);
+        return graph;
+    }
+
+    std::vector<int> _sources;
+    std::vector<int> _destinations;
+};
+
+using GraphMessageGroup = BasicGraphMessageGroup<>;
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_GRAPH_GROUP_HPP_
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_HIERARCHY_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_HIERARCHY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <mpi.h>
+#include <vector>
+
+#include <empi/defines.hpp>
+
+namespace empi::details {
+
+// Two level view of a communicator: the processes sharing a node (MPI_COMM_TYPE_SHARED)
+// and one leader per node, the lowest rank. The intra node step goes through a
+// shared memory segment, so only the leaders touch the network.
+// The segment is split in two halves used by alternate calls: a process still
+// reading the result of call k cannot be overwritten by call k+1, and call k+2
+// only starts writing after every process went through a barrier of call k+1.
+class node_hierarchy {
+  public:
+    explicit node_hierarchy(MPI_Comm comm) {
+        int rank, size;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &size);
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node);
+        MPI_Comm_rank(node, &node_rank);
+        MPI_Comm_size(node, &node_size);
+        MPI_Comm_split(comm, node_rank == 0 ? 0 : MPI_UNDEFINED, rank, &leaders);
+
+        // Leader of every rank of comm, as a rank of the leader communicator
+        int leader = 0;
+        if(leaders != MPI_COMM_NULL) MPI_Comm_rank(leaders, &leader);
+        MPI_Bcast(&leader, 1, MPI_INT, 0, node);
+        leader_of.resize(size);
+        MPI_Allgather(&leader, 1, MPI_INT, leader_of.data(), 1, MPI_INT, comm);
+        this_rank = rank;
+    }
+
+    node_hierarchy(const node_hierarchy &) = delete;
+    node_hierarchy &operator=(const node_hierarchy &) = delete;
+
+    ~node_hierarchy() {
+        release();
+        if(leaders != MPI_COMM_NULL) MPI_Comm_free(&leaders);
+        MPI_Comm_free(&node);
+    }
+
+    [[nodiscard]] int nodes() const { return *std::max_element(leader_of.begin(), leader_of.end()) + 1; }
+
+    [[nodiscard]] int local_rank() const { return node_rank; }
+
+    [[nodiscard]] int local_size() const { return node_size; }
+
+    // Reduce into a node slot with every process combining its own chunk of the
+    // elements, allreduce among leaders, copy back. op must be commutative, the
+    // slots are not combined in rank order.
+    int allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, MPI_Op op) {
+        if(sendbuf == MPI_IN_PLACE) sendbuf = recvbuf;
+
+        const MPI_Aint extent = type_extent(type);
+        const size_t bytes = static_cast<size_t>(count) * extent;
+        char *slots = segment(bytes * node_size);
+        std::memcpy(slots + node_rank * bytes, sendbuf, bytes);
+        sync();
+
+        const int chunk = (count + node_size - 1) / node_size;
+        const int first = std::min(count, chunk * node_rank);
+        const int len = std::min(count, first + chunk) - first;
+        if(len > 0)
+            for(int slot = 1; slot < node_size; slot++)
+                MPI_Reduce_local(slots + slot * bytes + first * extent, slots + first * extent, len, type, op);
+        sync();
+
+        int res = MPI_SUCCESS;
+        if(leaders != MPI_COMM_NULL) res = EMPI_ALLREDUCE(MPI_IN_PLACE, slots, count, type, op, leaders);
+        sync();
+        std::memcpy(recvbuf, slots, bytes);
+        return res;
+    }
+
+    // Root to the shared segment, leader of the root node to the other leaders,
+    // segment to every process
+    int bcast(void *data, int count, MPI_Datatype type, int root) {
+        const size_t bytes = static_cast<size_t>(count) * type_extent(type);
+        char *shared = segment(bytes);
+        const bool root_node = leader_of[root] == leader_of[this_rank];
+        if(root_node) {
+            if(this_rank == root) std::memcpy(shared, data, bytes);
+            sync();
+        }
+
+        int res = MPI_SUCCESS;
+        if(leaders != MPI_COMM_NULL) res = EMPI_BCAST(shared, count, type, leader_of[root], leaders);
+        sync();
+        if(this_rank != root) std::memcpy(data, shared, bytes);
+        return res;
+    }
+
+  private:
+    static constexpr size_t min_capacity = 4096;
+
+    static MPI_Aint type_extent(MPI_Datatype type) {
+        MPI_Aint lb, extent;
+        MPI_Type_get_extent(type, &lb, &extent);
+        return extent;
+    }
+
+    void sync() const {
+        MPI_Win_sync(win);
+        MPI_Barrier(node);
+        MPI_Win_sync(win);
+    }
+
+    // Half of the shared segment holding at least bytes, growing it (collectively
+    // on the node, every process asks for the same size) when needed
+    char *segment(size_t bytes) {
+        if(win == MPI_WIN_NULL || bytes > capacity) {
+            const size_t grown = std::max({bytes, 2 * capacity, min_capacity});
+            release();
+            capacity = grown;
+            const MPI_Aint local = node_rank == 0 ? static_cast<MPI_Aint>(2 * capacity) : 0;
+            MPI_Win_allocate_shared(local, 1, MPI_INFO_NULL, node, &base, &win);
+            MPI_Aint size;
+            int disp;
+            MPI_Win_shared_query(win, 0, &size, &disp, &base);
+            MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+        }
+        half ^= 1;
+        return static_cast<char *>(base) + half * capacity;
+    }
+
+    void release() {
+        if(win == MPI_WIN_NULL) return;
+        MPI_Win_unlock_all(win);
+        MPI_Win_free(&win);
+        capacity = 0;
+    }
+
+    MPI_Comm node = MPI_COMM_NULL;
+    MPI_Comm leaders = MPI_COMM_NULL;
+    MPI_Win win = MPI_WIN_NULL;
+    void *base = nullptr;
+    size_t capacity = 0;
+    int half = 0;
+    int node_rank;
+    int node_size;
+    int this_rank;
+    std::vector<int> leader_of;
+};
+
+} // namespace empi::details
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_HIERARCHY_HPP_
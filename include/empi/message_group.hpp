@@ -9,27 +9,40 @@
 #include <memory>
 #include <mpi.h>
 
+#include <empi/aggregator.hpp>
+#include <empi/collective_policy.hpp>
 #include <empi/message_grp_hdl.hpp>
 #include <empi/request_pool.hpp>
+#include <empi/shared_buffer.hpp>
 #include <empi/tag.hpp>
+#include <empi/trace.hpp>
 #include <empi/type_traits.hpp>
 #include <empi/utils.hpp>
+#include <empi/window.hpp>
 
 
 namespace empi {
-class MessageGroup {
+// Trace is the tracing policy of the group and of the handlers it runs, see
+// trace.hpp; MessageGroup is the untraced group
+template<typename Trace = no_trace>
+class BasicMessageGroup {
   public:
-    explicit MessageGroup(MPI_Comm comm, size_t pool_size = request_pool::default_pool_size) : comm(comm) {
+    using trace_policy = Trace;
+
+    explicit BasicMessageGroup(MPI_Comm comm, size_t pool_size = request_pool::default_pool_size) : comm(comm) {
         EMPI_CHECKCOMM(comm); // TODO: exception?
         MPI_Comm_rank(MPI_COMM_WORLD, &_rank);
         MPI_Comm_size(MPI_COMM_WORLD, &_size);
         _next = (_rank + 1) % _size;
         _prec = _rank == 0 ? (_size - 1) : (_rank - 1);
         _request_pool = std::make_shared<request_pool>(pool_size);
+#if !defined(EMPI_NO_TRACE_SCOPES)
+        Trace::attach(comm);
+#endif
     }
 
     // Wait an all Message in this group, so that no request is pending
-    ~MessageGroup() { wait_all(); }
+    virtual ~BasicMessageGroup() { wait_all(); }
 
     [[nodiscard]] int rank() const { return _rank; }
 
@@ -39,60 +52,109 @@ class MessageGroup {
 
     [[nodiscard]] int next() const { return _next; }
 
-    int barrier() { return MPI_Barrier(comm); }
+    int barrier() {
+        EMPI_TRACE_SCOPE(details::mpi_function::barrier, -1, -1, 0);
+        return MPI_Barrier(comm);
+    }
+
+    async_event Ibarrier() {
+        MessageGroupHandler<char, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.Ibarrier();
+    }
+
+    // Opt-in algorithm selection for Bcast and Allreduce: table picks, per message
+    // size, the MPI library collective (flat) or an EMPI one (hierarchical,
+    // pipelined chain/tree, ring). Collective over the group.
+    void set_collective_table(threshold_table table) { collectives().table = std::move(table); }
+
+    // Sizes left out of the collective table are picked by the tuning, set
+    // by Context on the groups it creates. Collective over the group.
+    void set_tuning(std::shared_ptr<details::tuning> tuning) { collectives().set_tuning(std::move(tuning)); }
+
+    // Posts through this group wake the Context progress thread, see Context::start_progress
+    void set_progress_signal(std::shared_ptr<details::progress_signal> signal) {
+        _request_pool->set_progress_signal(std::move(signal));
+    }
+
+    // Node shared segment of n elements per process, see empi::shared_buffer.
+    // Collective over the group.
+    template<typename T>
+    empi::shared_buffer<T> shared_buffer(size_t n) {
+        return empi::shared_buffer<T>(comm, n, _request_pool);
+    }
+
+    // Coalesces small messages per (dest, tag) in batches of up to capacity bytes,
+    // see empi::aggregator; wait_all flushes it. Collective over the group.
+    template<typename T>
+    empi::aggregator<T> aggregator(size_t capacity = empi::aggregator<T>::default_capacity) {
+        if(!_aggregators) _aggregators = std::make_shared<details::aggregator_registry>();
+        return empi::aggregator<T>(comm, capacity, _request_pool, _aggregators);
+    }
+
+    // RMA window of n elements per process, see empi::Window. Collective over the group.
+    template<typename T>
+    Window<T> create_window(size_t n) {
+        return Window<T>(comm, n, _request_pool);
+    }
+
+    // RMA window exposing n elements at base, which must outlive the window
+    template<typename T>
+    Window<T> create_window(T *base, size_t n) {
+        return Window<T>(comm, base, n, _request_pool);
+    }
 
     //---------------- SEND ------------------
 
     template<Tag tag, size_t size, typename T, typename C = typename T::value_type>
     int send(T &&data, int dest) {
-        MessageGroupHandler<C, tag, size> h(comm, _request_pool);
+        MessageGroupHandler<C, tag, size, Trace> h(comm, _request_pool);
         return h.template send(data, dest);
     }
 
     template<Tag tag, size_t size, typename T>
     int send(const T *data, int dest) {
-        MessageGroupHandler<T, tag, size> h(comm, _request_pool);
+        MessageGroupHandler<T, tag, size, Trace> h(comm, _request_pool);
         return h.template send(data, dest);
     }
 
     template<size_t size, typename T>
     int send(T &&data, int dest, Tag tag) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, NOTAG, size, Trace> h(comm, _request_pool);
             return h.template send(data, dest, tag);
         } else {
-            MessageGroupHandler<T, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<T, NOTAG, size, Trace> h(comm, _request_pool);
             return h.template send(data, dest, tag);
         }
     }
 
     template<size_t size, typename T>
     int send(const T *data, int dest, Tag tag) {
-        MessageGroupHandler<T, NOTAG, size> h(comm, _request_pool);
+        MessageGroupHandler<T, NOTAG, size, Trace> h(comm, _request_pool);
         return h.template send(data, dest, tag);
     }
 
     template<Tag tag, typename T, typename C = typename T::value_type>
     int send(T &&data, int dest, size_t size) {
-        MessageGroupHandler<C, tag, NOSIZE> h(comm, _request_pool);
+        MessageGroupHandler<C, tag, NOSIZE, Trace> h(comm, _request_pool);
         return h.template send(data, dest, size);
     }
 
     template<Tag tag, typename T>
     int send(const T *data, int dest, size_t size) {
-        MessageGroupHandler<T, tag, NOSIZE> h(comm, _request_pool);
+        MessageGroupHandler<T, tag, NOSIZE, Trace> h(comm, _request_pool);
         return h.template send(data, dest, size);
     }
 
     template<typename T, typename C = typename T::value_type>
     int send(T &&data, int dest, size_t size, Tag tag) {
-        MessageGroupHandler<C, NOTAG, NOSIZE> h(comm, _request_pool);
+        MessageGroupHandler<C, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
         return h.template send(data, dest, size, tag);
     }
 
     template<typename T>
     int send(const T *data, int dest, size_t size, Tag tag) {
-        MessageGroupHandler<T, NOTAG, NOSIZE> h(comm, _request_pool);
+        MessageGroupHandler<T, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
         return h.template send(data, dest, size, tag);
     }
 
@@ -100,119 +162,194 @@ class MessageGroup {
 
     template<Tag tag, size_t size, typename T, typename C = typename T::value_type>
     int recv(T &&data, int src, MPI_Status &status) {
-        MessageGroupHandler<C, tag, size> h(comm, _request_pool);
+        MessageGroupHandler<C, tag, size, Trace> h(comm, _request_pool);
         return h.recv(data, src, status);
     }
 
     template<Tag tag, size_t size, typename T>
     int recv(T *data, int src, MPI_Status &status) {
-        MessageGroupHandler<T, tag, size> h(comm, _request_pool);
+        MessageGroupHandler<T, tag, size, Trace> h(comm, _request_pool);
         return h.template recv(data, src, status);
     }
 
     // ------------------ ISEND --------------------------------------
 
     template<Tag tag, size_t size, typename T>
-    std::shared_ptr<async_event> Isend(T &&data, int dest) {
+    async_event Isend(T &&data, int dest) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, tag, size> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, tag, size, Trace> h(comm, _request_pool);
             return h.template Isend(data, dest);
         } else {
-            MessageGroupHandler<T, tag, size> h(comm, _request_pool);
+            MessageGroupHandler<T, tag, size, Trace> h(comm, _request_pool);
             return h.template Isend(data, dest);
         }
     }
 
     template<Tag tag, typename T>
-    std::shared_ptr<async_event> Isend(T &&data, int dest, int size) {
+    async_event Isend(T &&data, int dest, int size) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, tag, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, tag, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Isend(data, dest, size);
         } else {
-            MessageGroupHandler<T, tag, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<T, tag, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Isend(data, dest, size);
         }
     }
 
     template<int size, typename T>
-    std::shared_ptr<async_event> Isend(T &&data, int dest, Tag tag) {
+    async_event Isend(T &&data, int dest, Tag tag) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, NOTAG, size, Trace> h(comm, _request_pool);
             return h.template Isend(data, dest, tag);
         } else {
-            MessageGroupHandler<T, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<T, NOTAG, size, Trace> h(comm, _request_pool);
             return h.template Isend(data, dest, tag);
         }
     }
 
     template<typename T>
-    std::shared_ptr<async_event> Isend(T &&data, int dest, int size, Tag tag) {
+    async_event Isend(T &&data, int dest, int size, Tag tag) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, NOTAG, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Isend(data, dest, size, tag);
         } else {
-            MessageGroupHandler<T, NOTAG, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<T, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Isend(data, dest, size, tag);
         }
     }
 
+    template<Tag tag, viewable V>
+    async_event Isend(V &&data, int dest) {
+        MessageGroupHandler<std::remove_const_t<typename view_t<V>::element_type>, tag, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Isend(data, dest);
+    }
+
+    template<viewable V>
+    async_event Isend(V &&data, int dest, Tag tag) {
+        MessageGroupHandler<std::remove_const_t<typename view_t<V>::element_type>, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Isend(data, dest, tag);
+    }
+
     // ------------------ END ISEND --------------------------------------
     // ------------------ IRECV --------------------------------------
 
     template<Tag tag, size_t size, typename T>
-    std::shared_ptr<async_event> Irecv(T &&data, int src) {
+    async_event Irecv(T &&data, int src) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, tag, size> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, tag, size, Trace> h(comm, _request_pool);
             return h.template Irecv(data, src);
         } else {
-            MessageGroupHandler<T, tag, size> h(comm, _request_pool);
+            MessageGroupHandler<T, tag, size, Trace> h(comm, _request_pool);
             return h.template Irecv(data, src);
         }
     }
 
     template<size_t size, typename T>
-    std::shared_ptr<async_event> Irecv(T &&data, int src, Tag tag) {
+    async_event Irecv(T &&data, int src, Tag tag) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, NOTAG, size, Trace> h(comm, _request_pool);
             return h.template Irecv(data, src, tag);
         } else {
-            MessageGroupHandler<T, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<T, NOTAG, size, Trace> h(comm, _request_pool);
             return h.template Irecv(data, src, tag);
         }
     }
 
     template<Tag tag, typename T>
-    std::shared_ptr<async_event> Irecv(T &&data, int src, int size) {
+    async_event Irecv(T &&data, int src, int size) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, tag, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, tag, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Irecv(data, src, size);
         } else {
-            MessageGroupHandler<T, tag, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<T, tag, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Irecv(data, src, size);
         }
     }
 
     template<typename T>
-    std::shared_ptr<async_event> Irecv(T &&data, int src, int size, Tag tag) {
+    async_event Irecv(T &&data, int src, int size, Tag tag) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, NOTAG, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Irecv(data, src, size, tag);
         } else {
-            MessageGroupHandler<T, NOTAG, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<T, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Irecv(data, src, size, tag);
         }
     }
 
+    template<Tag tag, viewable V>
+    async_event Irecv(V &&data, int src) {
+        MessageGroupHandler<typename view_t<V>::element_type, tag, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Irecv(data, src);
+    }
+
+    template<viewable V>
+    async_event Irecv(V &&data, int src, Tag tag) {
+        MessageGroupHandler<typename view_t<V>::element_type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Irecv(data, src, tag);
+    }
+
     // ------------------ END IRECV --------------------------------------
+    // ------------------ PERSISTENT SEND/RECV --------------------------------------
+
+    template<Tag tag, size_t size, typename T>
+    persistent_channel persistent_send(T &&data, int dest) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, tag, size, Trace> h(comm, _request_pool);
+        return h.template persistent_send(data, dest);
+    }
+
+    template<Tag tag, typename T>
+    persistent_channel persistent_send(T &&data, int dest, int size) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, tag, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template persistent_send(data, dest, size);
+    }
+
+    template<size_t size, typename T>
+    persistent_channel persistent_send(T &&data, int dest, Tag tag) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template persistent_send(data, dest, tag);
+    }
+
+    template<typename T>
+    persistent_channel persistent_send(T &&data, int dest, int size, Tag tag) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template persistent_send(data, dest, size, tag);
+    }
+
+    template<Tag tag, size_t size, typename T>
+    persistent_channel persistent_recv(T &&data, int src) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, tag, size, Trace> h(comm, _request_pool);
+        return h.template persistent_recv(data, src);
+    }
+
+    template<Tag tag, typename T>
+    persistent_channel persistent_recv(T &&data, int src, int size) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, tag, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template persistent_recv(data, src, size);
+    }
+
+    template<size_t size, typename T>
+    persistent_channel persistent_recv(T &&data, int src, Tag tag) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template persistent_recv(data, src, tag);
+    }
+
+    template<typename T>
+    persistent_channel persistent_recv(T &&data, int src, int size, Tag tag) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template persistent_recv(data, src, size, tag);
+    }
+
+    // ------------------ END PERSISTENT SEND/RECV --------------------------------------
     // ------------------ BCAST -----------------------------
 
     template<size_t size, typename T>
     int Bcast(T &&data, int root) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, NOTAG, size, Trace> h(comm, _request_pool, _collectives.get());
             return h.template Bcast(std::forward<T>(data), root);
         } else {
-            MessageGroupHandler<T, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<T, NOTAG, size, Trace> h(comm, _request_pool, _collectives.get());
             return h.template Bcast(std::forward<T>(data), root);
         }
     }
@@ -220,35 +357,43 @@ class MessageGroup {
     template<typename T>
     int Bcast(T &&data, int root, int size) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, NOTAG, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, NOTAG, NOSIZE, Trace> h(comm, _request_pool, _collectives.get());
             return h.template Bcast(std::forward<T>(data), root, size);
         } else {
-            MessageGroupHandler<T, NOTAG, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<T, NOTAG, NOSIZE, Trace> h(comm, _request_pool, _collectives.get());
             return h.template Bcast(std::forward<T>(data), root, size);
         }
     }
 
+    // Explicit algorithm for this call, see collective_mode
+    template<typename T>
+    int Bcast(T &&data, int root, int size, collective_mode mode, size_t segment = default_segment_bytes) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(
+            comm, _request_pool, &collectives());
+        return h.template Bcast(std::forward<T>(data), root, size, mode, segment);
+    }
+
     // ------------------ END BCAST -----------------------------
     // ------------------ IBCAST -----------------------------
 
     template<size_t size, typename T>
-    std::shared_ptr<async_event> Ibcast(T &&data, int root) {
+    async_event Ibcast(T &&data, int root) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, NOTAG, size, Trace> h(comm, _request_pool);
             return h.template Ibcast(data, root);
         } else {
-            MessageGroupHandler<T, NOTAG, size> h(comm, _request_pool);
+            MessageGroupHandler<T, NOTAG, size, Trace> h(comm, _request_pool);
             return h.template Ibcast(data, root);
         }
     }
 
     template<typename T>
-    std::shared_ptr<async_event> Ibcast(T &&data, int root, int size) {
+    async_event Ibcast(T &&data, int root, int size) {
         if constexpr(has_data<T>) {
-            MessageGroupHandler<typename T::value_type, NOTAG, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<typename T::value_type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Ibcast(data, root, size);
         } else {
-            MessageGroupHandler<T, NOTAG, NOSIZE> h(comm, _request_pool);
+            MessageGroupHandler<T, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
             return h.template Ibcast(data, root, size);
         }
     }
@@ -258,29 +403,336 @@ class MessageGroup {
 
     template<size_t size, typename T>
     int Allreduce(T &&sendbuf, T &&recvbuf, MPI_Op op) {
-        MessageGroupHandler<typename get_true_type<T>::type, NOTAG, size> h(comm, _request_pool);
+        MessageGroupHandler<typename get_true_type<T>::type, NOTAG, size, Trace> h(comm, _request_pool, _collectives.get());
         return h.template Allreduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), op);
     }
 
     template<typename T>
     int Allreduce(T &&sendbuf, T &&recvbuf, int size, MPI_Op op) {
-        MessageGroupHandler<typename get_true_type<T>::type, NOTAG, NOSIZE> h(comm, _request_pool);
+        MessageGroupHandler<typename get_true_type<T>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool, _collectives.get());
         return h.template Allreduce(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, op);
     }
+
+    template<typename T>
+    int Allreduce(
+        T &&sendbuf, T &&recvbuf, int size, MPI_Op op, collective_mode mode, size_t segment = default_segment_bytes) {
+        MessageGroupHandler<typename get_true_type<T>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool, &collectives());
+        return h.template Allreduce(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, op, mode, segment);
+    }
+
+    template<size_t size, typename T, typename F>
+        requires reduction<F, typename get_true_type<remove_all_t<T>>::type>
+    int Allreduce(T &&sendbuf, T &&recvbuf, F &&op) {
+        MessageGroupHandler<typename get_true_type<T>::type, NOTAG, size, Trace> h(comm, _request_pool, _collectives.get());
+        return h.template Allreduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), std::forward<F>(op));
+    }
+
+    template<typename T, typename F>
+        requires reduction<F, typename get_true_type<remove_all_t<T>>::type>
+    int Allreduce(T &&sendbuf, T &&recvbuf, int size, F &&op) {
+        MessageGroupHandler<typename get_true_type<T>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool, _collectives.get());
+        return h.template Allreduce(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, std::forward<F>(op));
+    }
     // ------------------ END ALLREDUCE -----------------------------
+    // ------------------ REDUCE -----------------------------
+
+    template<size_t size, typename T>
+    int Reduce(T &&sendbuf, T &&recvbuf, MPI_Op op, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Reduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), op, root);
+    }
+
+    template<typename T>
+    int Reduce(T &&sendbuf, T &&recvbuf, int size, MPI_Op op, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Reduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, op, root);
+    }
+
+    template<size_t size, typename T, typename F>
+        requires reduction<F, typename get_true_type<remove_all_t<T>>::type>
+    int Reduce(T &&sendbuf, T &&recvbuf, F &&op, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Reduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), std::forward<F>(op), root);
+    }
+
+    template<typename T, typename F>
+        requires reduction<F, typename get_true_type<remove_all_t<T>>::type>
+    int Reduce(T &&sendbuf, T &&recvbuf, int size, F &&op, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Reduce<T>(
+            std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, std::forward<F>(op), root);
+    }
+    // ------------------ END REDUCE -----------------------------
+    // ------------------ SCATTER -----------------------------
+
+    template<size_t size, typename T>
+    int Scatter(T &&sendbuf, T &&recvbuf, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Scatter<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), root);
+    }
+
+    template<typename T>
+    int Scatter(T &&sendbuf, T &&recvbuf, int size, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Scatter<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, root);
+    }
+
+    template<typename T>
+    int Scatterv(int root, T &&sendbuf, int *sendcounts, int *displacements, T &&recvbuf, int recvcount) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Scatterv<T>(
+            root, std::forward<T>(sendbuf), sendcounts, displacements, std::forward<T>(recvbuf), recvcount);
+    }
+    // ------------------ END SCATTER -----------------------------
+    // ------------------ GATHER -----------------------------
+
+    template<size_t size, typename T>
+    int Gather(T &&sendbuf, T &&recvbuf, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Gather<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), root);
+    }
+
+    template<typename T>
+    int Gather(T &&sendbuf, T &&recvbuf, int size, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Gather<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, root);
+    }
+    // ------------------ END GATHER -----------------------------
+    // ------------------ ALLGATHER -----------------------------
+
+    template<size_t size, typename T>
+    int Allgather(T &&sendbuf, T &&recvbuf) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Allgather<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf));
+    }
+
+    template<typename T>
+    int Allgather(T &&sendbuf, T &&recvbuf, int size) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Allgather<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size);
+    }
+
+    template<typename T>
+    int Allgatherv(T &&sendbuf, int sendcount, T &&recvbuf, int *recvcounts, int *displacements) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Allgatherv<T>(
+            std::forward<T>(sendbuf), sendcount, std::forward<T>(recvbuf), recvcounts, displacements);
+    }
+    // ------------------ END ALLGATHER -----------------------------
+    // ------------------ ALLTOALL -----------------------------
+
+    template<size_t size, typename T>
+    int Alltoall(T &&sendbuf, T &&recvbuf) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Alltoall<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf));
+    }
+
+    template<typename T>
+    int Alltoall(T &&sendbuf, T &&recvbuf, int size) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Alltoall<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size);
+    }
+
+    template<typename T>
+    int Alltoallv(T &&sendbuf, int *sendcounts, int *sdispls, T &&recvbuf, int *recvcounts, int *rdispls) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Alltoallv<T>(
+            std::forward<T>(sendbuf), sendcounts, sdispls, std::forward<T>(recvbuf), recvcounts, rdispls);
+    }
+    // ------------------ END ALLTOALL -----------------------------
+    // ------------------ REDUCE_SCATTER -----------------------------
+
+    template<size_t size, typename T>
+    int Reduce_scatter(T &&sendbuf, T &&recvbuf, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Reduce_scatter<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), op);
+    }
+
+    template<typename T>
+    int Reduce_scatter(T &&sendbuf, T &&recvbuf, int size, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Reduce_scatter<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, op);
+    }
+
+    template<typename T>
+    int Reduce_scatter(T &&sendbuf, T &&recvbuf, int *recvcounts, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Reduce_scatter<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), recvcounts, op);
+    }
+    // ------------------ END REDUCE_SCATTER -----------------------------
+    // ------------------ SCAN -----------------------------
+
+    template<size_t size, typename T>
+    int Scan(T &&sendbuf, T &&recvbuf, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Scan<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), op);
+    }
+
+    template<typename T>
+    int Scan(T &&sendbuf, T &&recvbuf, int size, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Scan<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, op);
+    }
+    // ------------------ END SCAN -----------------------------
+    // ------------------ EXSCAN -----------------------------
+
+    template<size_t size, typename T>
+    int Exscan(T &&sendbuf, T &&recvbuf, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Exscan<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), op);
+    }
+
+    template<typename T>
+    int Exscan(T &&sendbuf, T &&recvbuf, int size, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Exscan<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, op);
+    }
+    // ------------------ END EXSCAN -----------------------------
+    // ------------------ IALLREDUCE -----------------------------
+
+    template<size_t size, typename T>
+    async_event Iallreduce(T &&sendbuf, T &&recvbuf, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Iallreduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), op);
+    }
+
+    template<typename T>
+    async_event Iallreduce(T &&sendbuf, T &&recvbuf, int size, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Iallreduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, op);
+    }
+
+    template<size_t size, typename T, typename F>
+        requires reduction<F, typename get_true_type<remove_all_t<T>>::type>
+    async_event Iallreduce(T &&sendbuf, T &&recvbuf, F &&op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Iallreduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), std::forward<F>(op));
+    }
+
+    template<typename T, typename F>
+        requires reduction<F, typename get_true_type<remove_all_t<T>>::type>
+    async_event Iallreduce(T &&sendbuf, T &&recvbuf, int size, F &&op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Iallreduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, std::forward<F>(op));
+    }
+    // ------------------ END IALLREDUCE -----------------------------
+    // ------------------ IREDUCE -----------------------------
+
+    template<size_t size, typename T>
+    async_event Ireduce(T &&sendbuf, T &&recvbuf, MPI_Op op, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Ireduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), op, root);
+    }
+
+    template<typename T>
+    async_event Ireduce(T &&sendbuf, T &&recvbuf, int size, MPI_Op op, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Ireduce<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, op, root);
+    }
+    // ------------------ END IREDUCE -----------------------------
+    // ------------------ PERSISTENT COLLECTIVES -----------------------------
+
+    template<size_t size, typename T>
+    persistent_collective Allreduce_init(T &&sendbuf, T &&recvbuf, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Allreduce_init<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), op);
+    }
+
+    template<typename T>
+    persistent_collective Allreduce_init(T &&sendbuf, T &&recvbuf, int size, MPI_Op op) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Allreduce_init<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size, op);
+    }
+
+    template<size_t size, typename T>
+    persistent_collective Bcast_init(T &&data, int root) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Bcast_init(std::forward<T>(data), root);
+    }
+
+    template<typename T>
+    persistent_collective Bcast_init(T &&data, int root, int size) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Bcast_init(std::forward<T>(data), root, size);
+    }
+    // ------------------ END PERSISTENT COLLECTIVES -----------------------------
     // ------------------ GATHERV -----------------------------
     template<typename T>
     int gatherv(int root, T &&sendbuf, int sendcount, T &&recvbuf, int *recvcounts, int *displacements) {
-        MessageGroupHandler<typename get_true_type<T>::type, NOTAG, NOSIZE> h(comm, _request_pool);
+        MessageGroupHandler<typename get_true_type<T>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
         return h.template gatherv(root, sendbuf, sendcount, recvbuf, recvcounts, displacements);
     }
+    // ------------------ END GATHERV -----------------------------
+    // ------------------ IGATHERV -----------------------------
+    template<typename T>
+    async_event Igatherv(int root, T &&sendbuf, int sendcount, T &&recvbuf, int *recvcounts, int *displacements) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Igatherv(root, sendbuf, sendcount, recvbuf, recvcounts, displacements);
+    }
+    // ------------------ END IGATHERV -----------------------------
+    // ------------------ IALLGATHER -----------------------------
+
+    template<size_t size, typename T>
+    async_event Iallgather(T &&sendbuf, T &&recvbuf) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Iallgather<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf));
+    }
+
+    template<typename T>
+    async_event Iallgather(T &&sendbuf, T &&recvbuf, int size) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Iallgather<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size);
+    }
+    // ------------------ END IALLGATHER -----------------------------
+    // ------------------ IALLTOALL -----------------------------
+
+    template<size_t size, typename T>
+    async_event Ialltoall(T &&sendbuf, T &&recvbuf) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, size, Trace> h(comm, _request_pool);
+        return h.template Ialltoall<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf));
+    }
+
+    template<typename T>
+    async_event Ialltoall(T &&sendbuf, T &&recvbuf, int size) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Ialltoall<T>(std::forward<T>(sendbuf), std::forward<T>(recvbuf), size);
+    }
+    // ------------------ END IALLTOALL -----------------------------
+    // ------------------ NEIGHBOR_ALLTOALLV -----------------------------
+    // Only valid on groups whose communicator has a process topology (see GraphMessageGroup)
+
+    template<typename T>
+    int Neighbor_alltoallv(T &&sendbuf, const int *sendcounts, const int *sdispls, T &&recvbuf,
+        const int *recvcounts, const int *rdispls) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Neighbor_alltoallv<T>(
+            std::forward<T>(sendbuf), sendcounts, sdispls, std::forward<T>(recvbuf), recvcounts, rdispls);
+    }
+
+    template<typename T>
+    async_event Ineighbor_alltoallv(T &&sendbuf, const int *sendcounts, const int *sdispls, T &&recvbuf,
+        const int *recvcounts, const int *rdispls) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Ineighbor_alltoallv<T>(
+            std::forward<T>(sendbuf), sendcounts, sdispls, std::forward<T>(recvbuf), recvcounts, rdispls);
+    }
+
+    template<typename T>
+    persistent_collective Neighbor_alltoallv_init(T &&sendbuf, const int *sendcounts, const int *sdispls, T &&recvbuf,
+        const int *recvcounts, const int *rdispls) {
+        MessageGroupHandler<typename get_true_type<remove_all_t<T>>::type, NOTAG, NOSIZE, Trace> h(comm, _request_pool);
+        return h.template Neighbor_alltoallv_init<T>(
+            std::forward<T>(sendbuf), sendcounts, sdispls, std::forward<T>(recvbuf), recvcounts, rdispls);
+    }
+    // ------------------ END NEIGHBOR_ALLTOALLV -----------------------------
 
 
     template<typename T>
     void run(T cgf) {
         typedef function_traits<decltype(cgf)> traits;
         using Handler = std::remove_reference_t<typename traits::template arg<0>::type>;
-        Handler cgh(comm, _request_pool);
+        static_assert(std::is_same_v<typename Handler::trace_policy, Trace>, "the handler must use the tracing policy of the group");
+        Handler cgh(comm, _request_pool, _collectives.get());
         cgf(cgh);
     }
 
@@ -288,21 +740,60 @@ class MessageGroup {
     void run_and_wait(T cgf) {
         typedef function_traits<decltype(cgf)> traits;
         using Handler = std::remove_reference_t<typename traits::template arg<0>::type>;
+        static_assert(std::is_same_v<typename Handler::trace_policy, Trace>, "the handler must use the tracing policy of the group");
 
-        Handler cgh(comm, _request_pool);
+        Handler cgh(comm, _request_pool, _collectives.get());
         cgf(cgh);
         wait_all();
     }
 
-    void wait_all() { _request_pool->waitall(); }
+    // Also sends the pending batches of the aggregators of this group
+    void wait_all() {
+        EMPI_TRACE_SCOPE(details::mpi_function::wait, -1, -1, 0);
+        if(_aggregators) _aggregators->flush_all();
+        _request_pool->waitall();
+    }
 
-  private:
+    bool test_all() { return _request_pool->testall(); }
+
+    int wait_some() {
+        EMPI_TRACE_SCOPE(details::mpi_function::wait, -1, -1, 0);
+        return _request_pool->waitsome();
+    }
+
+    void wait_all_local() {
+        EMPI_TRACE_SCOPE(details::mpi_function::wait, -1, -1, 0);
+        _request_pool->waitall_local();
+    }
+
+    // Same as event.wait<no_status>(), traced as a wait of this group
+    void wait(const async_event &event) {
+        EMPI_TRACE_SCOPE(details::mpi_function::wait, -1, -1, 0);
+        event.wait<details::no_status>();
+    }
+
+    // Runs the continuations (async_event::then) of the calling thread whose
+    // events completed, posted through any group; returns how many ran
+    int progress() { return empi::progress(); }
+
+  protected:
     MPI_Comm comm;
     std::shared_ptr<request_pool> _request_pool;
     int _prec;
     int _next;
     int _rank;
     int _size;
+    std::unique_ptr<details::collective_policy> _collectives;
+    std::shared_ptr<details::aggregator_registry> _aggregators; // Created with the first aggregator
+
+  private:
+    // Created on first use, with an empty (all flat) table and no tuning
+    details::collective_policy &collectives() {
+        if(!_collectives) _collectives = std::make_unique<details::collective_policy>(comm, _request_pool);
+        return *_collectives;
+    }
 };
+
+using MessageGroup = BasicMessageGroup<>;
 } // namespace empi
 #endif // EMPI_PROJECT_INCLUDE_EMPI_MESSAGE_GROUP_HPP_
@@ -8,6 +8,7 @@
 #include "mpi.h"
 #include <memory>
 #include <limits>
+#include <stdexcept>
 
 #include <empi/request_pool.hpp>
 #include <empi/type_traits.hpp>
@@ -15,26 +16,31 @@
 
 #include <empi/request.hpp>
 #include <empi/async_event.hpp>
+#include <empi/persistent.hpp>
+#include <empi/view.hpp>
 #include <empi/utils.hpp>
 #include <empi/datatype.hpp>
 #include <empi/defines.hpp>
+#include <empi/collective_policy.hpp>
+#include <empi/op.hpp>
+#include <empi/trace.hpp>
 
 namespace empi{
 
 
-	template<typename T1, Tag TAG = NOTAG, std::size_t SIZE = 0>
+	// Trace is the tracing policy, no_trace or recording_trace (see trace.hpp); it must
+	// match the one of the group running the handler
+	template<typename T1, Tag TAG = NOTAG, std::size_t SIZE = 0, typename Trace = no_trace>
 	class MessageGroupHandler{
 
 	  	using T = remove_all_t<T1>;
 
 		public:
-		  explicit MessageGroupHandler(MPI_Comm comm, std::shared_ptr<request_pool> _request_pool) : communicator(comm), _request_pool(_request_pool) {
+		  using trace_policy = Trace;
+
+		  explicit MessageGroupHandler(MPI_Comm comm, std::shared_ptr<request_pool> _request_pool, details::collective_policy* collectives = nullptr)
+			: communicator(comm), _request_pool(_request_pool), collectives(collectives), max_tag(details::tag_ub()) {
 			// MPI_Datatype type = details::mpi_type<T>::get_type();
-			// int flag;
-			// MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &max_tag, &flag);
-			// if(!flag){
-			//   max_tag = -1;
-			// }
 			// EMPI_CHECKTYPE(type); //TODO: exceptions?
 		  }
 
@@ -44,23 +50,54 @@ namespace empi{
 		 // -------------- UTILITY -----------------------------
 
 		int inline barrier() const {
+			EMPI_TRACE_SCOPE(details::mpi_function::barrier, -1, -1, 0);
 			return MPI_Barrier(communicator);
 		}
 
+		async_event Ibarrier() {
+			EMPI_TRACE_SCOPE(details::mpi_function::ibarrier, -1, -1, 0);
+			auto event = _request_pool->get_req();
+			event.res = EMPI_IBARRIER(communicator, event.get_request());
+			return event;
+		}
+
 		void waitall() {
+			EMPI_TRACE_SCOPE(details::mpi_function::wait, -1, -1, 0);
 			_request_pool->waitall();
 		}
 
+		bool testall() {
+			return _request_pool->testall();
+		}
+
+		int waitsome() {
+			EMPI_TRACE_SCOPE(details::mpi_function::wait, -1, -1, 0);
+			return _request_pool->waitsome();
+		}
+
+		// Only completes the requests posted by the calling thread, safe inside a parallel region
+		void waitall_local() {
+			EMPI_TRACE_SCOPE(details::mpi_function::wait, -1, -1, 0);
+			_request_pool->waitall_local();
+		}
+
+		// Runs the completed continuations of the calling thread, see async_event::then
+		int progress() {
+			return empi::progress();
+		}
+
 		  // -------------- SEND -----------------------------------------
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG != -1)
 		  int send(K&& data, int dest){
+			EMPI_TRACE_SCOPE(details::mpi_function::send, dest, TAG.value, SIZE * sizeof(T));
 			return EMPI_SEND(details::get_underlying_pointer(data), SIZE,  details::mpi_type<T>::get_type(), dest, TAG.value, communicator);
 		  }
 
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG == NOTAG)
 		  int send(K&& data, int dest, Tag tag){
+			EMPI_TRACE_SCOPE(details::mpi_function::send, dest, tag.value, SIZE * sizeof(T));
 			details::checktag<details::mpi_function::send>(tag.value, max_tag);
 			return EMPI_SEND(details::get_underlying_pointer(data), SIZE,  details::mpi_type<T>::get_type(), dest, tag.value, communicator);
 		  }
@@ -68,12 +105,14 @@ namespace empi{
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG != -1)
 		  int inline send(K&& data, int dest, size_t size){
+			EMPI_TRACE_SCOPE(details::mpi_function::send, dest, TAG.value, size * sizeof(T));
 			return EMPI_SEND(details::get_underlying_pointer(data), size,  details::mpi_type<T>::get_type(), dest, TAG.value, communicator);
 		  }
 
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG == NOTAG)
 		  int send(K&& data, int dest, size_t size, Tag tag){
+			EMPI_TRACE_SCOPE(details::mpi_function::send, dest, tag.value, size * sizeof(T));
 			details::checktag<details::mpi_function::send>(tag.value, max_tag);
 			return EMPI_SEND(details::get_underlying_pointer(data), size,  details::mpi_type<T>::get_type(), dest, tag.value, communicator);
 		  }
@@ -85,12 +124,14 @@ namespace empi{
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG.value >= -1)
 		  int recv(K&& data, int src, MPI_Status& status){
+			EMPI_TRACE_SCOPE(details::mpi_function::recv, src, TAG.value, SIZE * sizeof(T));
 			return EMPI_RECV(details::get_underlying_pointer(data), SIZE,  details::mpi_type<T>::get_type(), src, TAG.value, communicator, &status);
 		  }
 
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG.value >= -1)
 		  int inline recv(K&& data, int src, size_t size, MPI_Status& status){
+			EMPI_TRACE_SCOPE(details::mpi_function::recv, src, TAG.value, size * sizeof(T));
 			return EMPI_RECV(details::get_underlying_pointer(data), size,  details::mpi_type<T>::get_type(), src, TAG.value, communicator, &status);
 		  }
 
@@ -98,6 +139,7 @@ namespace empi{
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG == NOTAG)
 		  int recv(K&& data, int src, Tag tag, MPI_Status& status){
+			EMPI_TRACE_SCOPE(details::mpi_function::recv, src, tag.value, SIZE * sizeof(T));
 			details::checktag<details::mpi_function::recv>(tag.value, max_tag);
 			return EMPI_RECV(details::get_underlying_pointer(data), SIZE,  details::mpi_type<T>::get_type(), src, tag.value, communicator, &status);
 		  }
@@ -105,6 +147,7 @@ namespace empi{
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG == NOTAG)
 		  int recv(K&& data, int src, size_t size, Tag tag, MPI_Status& status){
+			EMPI_TRACE_SCOPE(details::mpi_function::recv, src, tag.value, size * sizeof(T));
 			details::checktag<details::mpi_function::recv>(tag.value, max_tag);
 			return EMPI_RECV(details::get_underlying_pointer(data), size,  details::mpi_type<T>::get_type(), src, tag.value, communicator, &status);
 		  }
@@ -115,36 +158,62 @@ namespace empi{
 		  // ------------------------- START ISEND --------------------------
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG != -1)
-		  std::shared_ptr<async_event>& Isend(K&& data, int dest){
-			auto&& event = _request_pool->get_req();
-			event->res = EMPI_ISEND(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),dest,TAG.value,communicator,event->request.get());
+		  async_event Isend(K&& data, int dest){
+			EMPI_TRACE_SCOPE(details::mpi_function::isend, dest, TAG.value, SIZE * sizeof(T));
+			auto event = _request_pool->get_req();
+			event.res = EMPI_ISEND(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),dest,TAG.value,communicator,event.get_request());
 			return event;
 		  }
 
 
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG != -1)
-		  std::shared_ptr<async_event>& Isend(K&& data, int dest, int size){
-			auto&& event = _request_pool->get_req();
-			event->res = EMPI_ISEND(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(),dest,TAG.value,communicator,event->get_request());
+		  async_event Isend(K&& data, int dest, int size){
+			EMPI_TRACE_SCOPE(details::mpi_function::isend, dest, TAG.value, size * sizeof(T));
+			auto event = _request_pool->get_req();
+			event.res = EMPI_ISEND(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(),dest,TAG.value,communicator,event.get_request());
 			return event;
 		  }
 
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG == NOTAG)
-		  std::shared_ptr<async_event>& Isend(K&& data, int dest, Tag tag){
+		  async_event Isend(K&& data, int dest, Tag tag){
+			EMPI_TRACE_SCOPE(details::mpi_function::isend, dest, tag.value, SIZE * sizeof(T));
 			details::checktag<details::mpi_function::isend>(tag.value, max_tag);
-			auto&& event = _request_pool->get_req();
-			event->res = EMPI_ISEND(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),dest,tag.value,communicator,event->request.get());
+			auto event = _request_pool->get_req();
+			event.res = EMPI_ISEND(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),dest,tag.value,communicator,event.get_request());
 			return event;
 		  }
 
 		  template<typename K>
 		  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG == NOTAG)
-		  std::shared_ptr<async_event>& Isend(K&& data, int dest, int size, Tag tag){
+		  async_event Isend(K&& data, int dest, int size, Tag tag){
+			EMPI_TRACE_SCOPE(details::mpi_function::isend, dest, tag.value, size * sizeof(T));
+			details::checktag<details::mpi_function::isend>(tag.value, max_tag);
+			auto event = _request_pool->get_req();
+			event.res = EMPI_ISEND(details::get_underlying_pointer(data),size, details::mpi_type<T>::get_type(),dest,tag.value,communicator,event.get_request());
+			return event;
+		  }
+
+		  // Strided views are sent in place as one element of a cached derived datatype
+		  template<typename V>
+		  requires is_valid_view<V,T> && (TAG != -1)
+		  async_event Isend(V&& data, int dest){
+			const auto v = view(data);
+			EMPI_TRACE_SCOPE(details::mpi_function::isend, dest, TAG.value, v.size() * sizeof(T));
+			auto event = _request_pool->get_req();
+			event.res = EMPI_ISEND(v.base, 1, details::view_type<T>(v.extents, v.strides),dest,TAG.value,communicator,event.get_request());
+			return event;
+		  }
+
+		  template<typename V>
+		  requires is_valid_view<V,T> && (TAG == NOTAG)
+		  async_event Isend(V&& data, int dest, Tag tag){
 			details::checktag<details::mpi_function::isend>(tag.value, max_tag);
-			auto&& event = _request_pool->get_req();
-			event->res = EMPI_ISEND(details::get_underlying_pointer(data),size, details::mpi_type<T>::get_type(),dest,tag.value,communicator,event->request.get());
+			const auto v = view(data);
+			EMPI_TRACE_SCOPE(details::mpi_function::isend, dest, tag.value, v.size() * sizeof(T));
+			auto event = _request_pool->get_req();
+			event.res = EMPI_ISEND(v.base, 1, details::view_type<T>(v.extents, v.strides),dest,tag.value,communicator,event.get_request());
 			return event;
 		  }
 
@@ -155,73 +224,190 @@ namespace empi{
 
 		template<typename K>
 		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG >= -2)
-		std::shared_ptr<async_event>& Irecv(K&& data, int src){
-		  auto&& event = _request_pool->get_req();
-		  event->res = EMPI_IRECV(details::get_underlying_pointer(data),SIZE, details::mpi_type<T>::get_type(),src,TAG.value,communicator,event->request.get());
+		async_event Irecv(K&& data, int src){
+		  EMPI_TRACE_SCOPE(details::mpi_function::irecv, src, TAG.value, SIZE * sizeof(T));
+		  auto event = _request_pool->get_req();
+		  event.res = EMPI_IRECV(details::get_underlying_pointer(data),SIZE, details::mpi_type<T>::get_type(),src,TAG.value,communicator,event.get_request());
 
 		  return event;
 		}
 
 		template<typename K>
 		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG >= -2)
-		std::shared_ptr<async_event>& Irecv(K&& data, int src, int size){
-		  auto&& event = _request_pool->get_req();
-		  event->res = EMPI_IRECV(details::get_underlying_pointer(data),size, details::mpi_type<T>::get_type(),src,TAG.value,communicator,event->request.get());
+		async_event Irecv(K&& data, int src, int size){
+		  EMPI_TRACE_SCOPE(details::mpi_function::irecv, src, TAG.value, size * sizeof(T));
+		  auto event = _request_pool->get_req();
+		  event.res = EMPI_IRECV(details::get_underlying_pointer(data),size, details::mpi_type<T>::get_type(),src,TAG.value,communicator,event.get_request());
 
 		  return event;
 		}
 
 		template<typename K>
 		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG == NOTAG)
-		std::shared_ptr<async_event>& Irecv(K&& data, int src, Tag tag){
+		async_event Irecv(K&& data, int src, Tag tag){
+		  EMPI_TRACE_SCOPE(details::mpi_function::irecv, src, tag.value, SIZE * sizeof(T));
 		  details::checktag<details::mpi_function::irecv>(tag.value, max_tag);
-		  auto&& event = _request_pool->get_req();
-		  event->res = EMPI_IRECV(details::get_underlying_pointer(data),SIZE, details::mpi_type<T>::get_type(),src,tag.value,communicator,event->request.get());
+		  auto event = _request_pool->get_req();
+		  event.res = EMPI_IRECV(details::get_underlying_pointer(data),SIZE, details::mpi_type<T>::get_type(),src,tag.value,communicator,event.get_request());
 
 		  return event;
 		}
 
 		template<typename K>
 		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG == NOTAG)
-		std::shared_ptr<async_event>& Irecv(K&& data, int src, int size, Tag tag){
+		async_event Irecv(K&& data, int src, int size, Tag tag){
+		  EMPI_TRACE_SCOPE(details::mpi_function::irecv, src, tag.value, size * sizeof(T));
 		  details::checktag<details::mpi_function::irecv>(tag.value, max_tag);
-		  auto&& event = _request_pool->get_req();
-		  event->res = EMPI_IRECV(details::get_underlying_pointer(data),size, details::mpi_type<T>::get_type(),src,tag.value,communicator,event->request.get());
+		  auto event = _request_pool->get_req();
+		  event.res = EMPI_IRECV(details::get_underlying_pointer(data),size, details::mpi_type<T>::get_type(),src,tag.value,communicator,event.get_request());
+
+		  return event;
+		}
+
+		template<typename V>
+		requires is_valid_view<V,T> && (TAG >= -2)
+		async_event Irecv(V&& data, int src){
+		  const auto v = view(data);
+		  EMPI_TRACE_SCOPE(details::mpi_function::irecv, src, TAG.value, v.size() * sizeof(T));
+		  auto event = _request_pool->get_req();
+		  event.res = EMPI_IRECV(v.base, 1, details::view_type<T>(v.extents, v.strides),src,TAG.value,communicator,event.get_request());
+		  return event;
+		}
 
+		template<typename V>
+		requires is_valid_view<V,T> && (TAG == NOTAG)
+		async_event Irecv(V&& data, int src, Tag tag){
+		  details::checktag<details::mpi_function::irecv>(tag.value, max_tag);
+		  const auto v = view(data);
+		  EMPI_TRACE_SCOPE(details::mpi_function::irecv, src, tag.value, v.size() * sizeof(T));
+		  auto event = _request_pool->get_req();
+		  event.res = EMPI_IRECV(v.base, 1, details::view_type<T>(v.extents, v.strides),src,tag.value,communicator,event.get_request());
 		  return event;
 		}
 
 	  // ------------------------- END URECV --------------------------
+	  // ------------------------- PERSISTENT SEND --------------------------
+
+		template<typename K>
+		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG != -1)
+		persistent_channel persistent_send(K&& data, int dest){
+		  persistent_channel channel;
+		  channel.res = EMPI_SEND_INIT(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),dest,TAG.value,communicator,channel.get_request());
+		  return channel;
+		}
+
+		template<typename K>
+		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG != -1)
+		persistent_channel persistent_send(K&& data, int dest, int size){
+		  persistent_channel channel;
+		  channel.res = EMPI_SEND_INIT(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(),dest,TAG.value,communicator,channel.get_request());
+		  return channel;
+		}
+
+		template<typename K>
+		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG == NOTAG)
+		persistent_channel persistent_send(K&& data, int dest, Tag tag){
+		  details::checktag<details::mpi_function::isend>(tag.value, max_tag);
+		  persistent_channel channel;
+		  channel.res = EMPI_SEND_INIT(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),dest,tag.value,communicator,channel.get_request());
+		  return channel;
+		}
+
+		template<typename K>
+		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG == NOTAG)
+		persistent_channel persistent_send(K&& data, int dest, int size, Tag tag){
+		  details::checktag<details::mpi_function::isend>(tag.value, max_tag);
+		  persistent_channel channel;
+		  channel.res = EMPI_SEND_INIT(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(),dest,tag.value,communicator,channel.get_request());
+		  return channel;
+		}
+
+	  // ------------------------- END PERSISTENT SEND --------------------------
+	  // ------------------------- PERSISTENT RECV --------------------------
+
+		template<typename K>
+		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG >= -2)
+		persistent_channel persistent_recv(K&& data, int src){
+		  persistent_channel channel;
+		  channel.res = EMPI_RECV_INIT(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),src,TAG.value,communicator,channel.get_request());
+		  return channel;
+		}
+
+		template<typename K>
+		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG >= -2)
+		persistent_channel persistent_recv(K&& data, int src, int size){
+		  persistent_channel channel;
+		  channel.res = EMPI_RECV_INIT(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(),src,TAG.value,communicator,channel.get_request());
+		  return channel;
+		}
+
+		template<typename K>
+		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && (TAG == NOTAG)
+		persistent_channel persistent_recv(K&& data, int src, Tag tag){
+		  details::checktag<details::mpi_function::irecv>(tag.value, max_tag);
+		  persistent_channel channel;
+		  channel.res = EMPI_RECV_INIT(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),src,tag.value,communicator,channel.get_request());
+		  return channel;
+		}
+
+		template<typename K>
+		requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && (TAG == NOTAG)
+		persistent_channel persistent_recv(K&& data, int src, int size, Tag tag){
+		  details::checktag<details::mpi_function::irecv>(tag.value, max_tag);
+		  persistent_channel channel;
+		  channel.res = EMPI_RECV_INIT(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(),src,tag.value,communicator,channel.get_request());
+		  return channel;
+		}
+
+	  // ------------------------- END PERSISTENT RECV --------------------------
 	  // ------------------------- BCAST --------------------------
 
 	  template<typename K>
 	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
 	  int Bcast(K&& data, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::bcast, root, -1, SIZE * sizeof(T));
+		if(collectives)
+			return collectives->bcast(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(), root);
 		return EMPI_BCAST(details::get_underlying_pointer(std::forward<K>(data)), SIZE, details::mpi_type<T>::get_type(),root,communicator);
 	  }
 
 	  template<typename K>
 	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
 	  int Bcast(K&& data, int root, int size){
+		EMPI_TRACE_SCOPE(details::mpi_function::bcast, root, -1, size * sizeof(T));
+		if(collectives)
+			return collectives->bcast(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(), root);
 		return EMPI_BCAST(details::get_underlying_pointer(std::forward<K>(data)), size, details::mpi_type<T>::get_type(),root,communicator);
 	  }
 
+	  // Explicit algorithm for this call, ignoring the group's table. The group must
+	  // have a collective table (MessageGroup::set_collective_table).
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Bcast(K&& data, int root, int size, collective_mode mode, size_t segment = default_segment_bytes){
+		EMPI_TRACE_SCOPE(details::mpi_function::bcast, root, -1, size * sizeof(T));
+		if(!collectives) throw std::logic_error("Bcast: explicit algorithms need a group with a collective table");
+		return collectives->bcast(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(), root, mode, segment);
+	  }
+
 	  // ------------------------- END BCAST --------------------------
 	  // ------------------------- IBCAST --------------------------
 
 	  template<typename K>
 	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
-	  std::shared_ptr<async_event>& Ibcast(K&& data, int root){
-		auto&& event = _request_pool->get_req();
-		event->res = EMPI_IBCAST(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),root,communicator, event->get_request());
+	  async_event Ibcast(K&& data, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::ibcast, root, -1, SIZE * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IBCAST(details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(),root,communicator, event.get_request());
 		return event;
 	  }
 
 	  template<typename K>
 	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
-	  std::shared_ptr<async_event>& Ibcast(K&& data, int root, int size){
-		auto&& event = _request_pool->get_req();
-		event->res = EMPI_IBCAST(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(),root,communicator, event->get_request());
+	  async_event Ibcast(K&& data, int root, int size){
+		EMPI_TRACE_SCOPE(details::mpi_function::ibcast, root, -1, size * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IBCAST(details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(),root,communicator, event.get_request());
 		return event;
 	  }
 
@@ -231,20 +417,319 @@ namespace empi{
 	  template<typename K>
 	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
 	  int Allreduce(K&& sendbuf, K&& recvbuf, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::allreduce, -1, -1, SIZE * sizeof(T));
+		if(collectives)
+			return collectives->allreduce(details::get_underlying_pointer(sendbuf), details::get_underlying_pointer(recvbuf), SIZE, details::mpi_type<T>::get_type(), op);
 		return EMPI_ALLREDUCE(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),op,communicator);
 	  }
 
 	  template<typename K>
 	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
 	  int Allreduce(K&& sendbuf, K&& recvbuf, int size, MPI_Op op){
-			return EMPI_ALLREDUCE(sendbuf,recvbuf,size,details::mpi_type<T>::get_type(),op,communicator);
+			EMPI_TRACE_SCOPE(details::mpi_function::allreduce, -1, -1, size * sizeof(T));
+			if(collectives)
+				return collectives->allreduce(details::get_underlying_pointer(sendbuf), details::get_underlying_pointer(recvbuf), size, details::mpi_type<T>::get_type(), op);
+			return EMPI_ALLREDUCE(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),op,communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Allreduce(K&& sendbuf, K&& recvbuf, int size, MPI_Op op, collective_mode mode, size_t segment = default_segment_bytes){
+		EMPI_TRACE_SCOPE(details::mpi_function::allreduce, -1, -1, size * sizeof(T));
+		if(!collectives) throw std::logic_error("Allreduce: explicit algorithms need a group with a collective table");
+		return collectives->allreduce(details::get_underlying_pointer(sendbuf), details::get_underlying_pointer(recvbuf), size, details::mpi_type<T>::get_type(), op, mode, segment);
+	  }
+
+	  // Stateless lambda reductions, turned into a cached MPI_Op (see make_op)
+	  template<typename K, typename F>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && reduction<F,T>
+	  int Allreduce(K&& sendbuf, K&& recvbuf, F&& op){
+		return Allreduce(std::forward<K>(sendbuf), std::forward<K>(recvbuf), make_op<T>(op));
+	  }
+
+	  template<typename K, typename F>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && reduction<F,T>
+	  int Allreduce(K&& sendbuf, K&& recvbuf, int size, F&& op){
+		return Allreduce(std::forward<K>(sendbuf), std::forward<K>(recvbuf), size, make_op<T>(op));
 	  }
 
 	  // ------------------------- END ALLREDUCE --------------------------
+	  // ------------------------- REDUCE --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  int Reduce(K&& sendbuf, K&& recvbuf, MPI_Op op, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::reduce, root, -1, SIZE * sizeof(T));
+		return EMPI_REDUCE(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),op,root,communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Reduce(K&& sendbuf, K&& recvbuf, int size, MPI_Op op, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::reduce, root, -1, size * sizeof(T));
+		return EMPI_REDUCE(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),op,root,communicator);
+	  }
+
+	  template<typename K, typename F>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && reduction<F,T>
+	  int Reduce(K&& sendbuf, K&& recvbuf, F&& op, int root){
+		return Reduce(std::forward<K>(sendbuf), std::forward<K>(recvbuf), make_op<T>(op), root);
+	  }
+
+	  template<typename K, typename F>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && reduction<F,T>
+	  int Reduce(K&& sendbuf, K&& recvbuf, int size, F&& op, int root){
+		return Reduce(std::forward<K>(sendbuf), std::forward<K>(recvbuf), size, make_op<T>(op), root);
+	  }
+
+	  // ------------------------- END REDUCE --------------------------
+	  // ------------------------- SCATTER --------------------------
+	  // SIZE (or size) is the number of elements received by each rank
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  int Scatter(K&& sendbuf, K&& recvbuf, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::scatter, root, -1, SIZE * sizeof(T));
+		return EMPI_SCATTER(details::get_underlying_pointer(sendbuf),SIZE,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),root,communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Scatter(K&& sendbuf, K&& recvbuf, int size, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::scatter, root, -1, size * sizeof(T));
+		return EMPI_SCATTER(details::get_underlying_pointer(sendbuf),size,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),root,communicator);
+	  }
+
+	  // ------------------------- END SCATTER --------------------------
+	  // ------------------------- SCATTERV --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>)
+	  int Scatterv(int root, K&& sendbuf, int* sendcounts, int* displacements, K&& recvbuf, int recvcount){
+		EMPI_TRACE_SCOPE(details::mpi_function::scatterv, root, -1, recvcount * sizeof(T));
+		return EMPI_SCATTERV(details::get_underlying_pointer(sendbuf),sendcounts,displacements,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),recvcount,details::mpi_type<T>::get_type(),root,communicator);
+	  }
+
+	  // ------------------------- END SCATTERV --------------------------
+	  // ------------------------- GATHER --------------------------
+	  // SIZE (or size) is the number of elements sent by each rank
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  int Gather(K&& sendbuf, K&& recvbuf, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::gather, root, -1, SIZE * sizeof(T));
+		return EMPI_GATHER(details::get_underlying_pointer(sendbuf),SIZE,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),root,communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Gather(K&& sendbuf, K&& recvbuf, int size, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::gather, root, -1, size * sizeof(T));
+		return EMPI_GATHER(details::get_underlying_pointer(sendbuf),size,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),root,communicator);
+	  }
+
+	  // ------------------------- END GATHER --------------------------
+	  // ------------------------- ALLGATHER --------------------------
+	  // SIZE (or size) is the number of elements contributed by each rank
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  int Allgather(K&& sendbuf, K&& recvbuf){
+		EMPI_TRACE_SCOPE(details::mpi_function::allgather, -1, -1, SIZE * sizeof(T));
+		return EMPI_ALLGATHER(details::get_underlying_pointer(sendbuf),SIZE,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Allgather(K&& sendbuf, K&& recvbuf, int size){
+		EMPI_TRACE_SCOPE(details::mpi_function::allgather, -1, -1, size * sizeof(T));
+		return EMPI_ALLGATHER(details::get_underlying_pointer(sendbuf),size,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),communicator);
+	  }
+
+	  // ------------------------- END ALLGATHER --------------------------
+	  // ------------------------- ALLGATHERV --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>)
+	  int Allgatherv(K&& sendbuf, int sendcount, K&& recvbuf, int* recvcounts, int* displacements){
+		EMPI_TRACE_SCOPE(details::mpi_function::allgatherv, -1, -1, sendcount * sizeof(T));
+		return EMPI_ALLGATHERV(details::get_underlying_pointer(sendbuf),sendcount,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),recvcounts,displacements,details::mpi_type<T>::get_type(),communicator);
+	  }
+
+	  // ------------------------- END ALLGATHERV --------------------------
+	  // ------------------------- ALLTOALL --------------------------
+	  // SIZE (or size) is the number of elements exchanged with each rank
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  int Alltoall(K&& sendbuf, K&& recvbuf){
+		EMPI_TRACE_SCOPE(details::mpi_function::alltoall, -1, -1, SIZE * sizeof(T));
+		return EMPI_ALLTOALL(details::get_underlying_pointer(sendbuf),SIZE,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Alltoall(K&& sendbuf, K&& recvbuf, int size){
+		EMPI_TRACE_SCOPE(details::mpi_function::alltoall, -1, -1, size * sizeof(T));
+		return EMPI_ALLTOALL(details::get_underlying_pointer(sendbuf),size,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),communicator);
+	  }
+
+	  // ------------------------- END ALLTOALL --------------------------
+	  // ------------------------- ALLTOALLV --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>)
+	  int Alltoallv(K&& sendbuf, int* sendcounts, int* sdispls, K&& recvbuf, int* recvcounts, int* rdispls){
+		EMPI_TRACE_SCOPE(details::mpi_function::alltoallv, -1, -1, 0);
+		return EMPI_ALLTOALLV(details::get_underlying_pointer(sendbuf),sendcounts,sdispls,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),recvcounts,rdispls,details::mpi_type<T>::get_type(),communicator);
+	  }
+
+	  // ------------------------- END ALLTOALLV --------------------------
+	  // ------------------------- REDUCE_SCATTER --------------------------
+	  // Without counts every rank receives SIZE (or size) elements of the reduction
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  int Reduce_scatter(K&& sendbuf, K&& recvbuf, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::reduce_scatter, -1, -1, SIZE * sizeof(T));
+		return EMPI_REDUCE_SCATTER_BLOCK(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),op,communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Reduce_scatter(K&& sendbuf, K&& recvbuf, int size, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::reduce_scatter, -1, -1, size * sizeof(T));
+		return EMPI_REDUCE_SCATTER_BLOCK(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),op,communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>)
+	  int Reduce_scatter(K&& sendbuf, K&& recvbuf, int* recvcounts, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::reduce_scatter, -1, -1, 0);
+		return EMPI_REDUCE_SCATTER(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),recvcounts,details::mpi_type<T>::get_type(),op,communicator);
+	  }
+
+	  // ------------------------- END REDUCE_SCATTER --------------------------
+	  // ------------------------- SCAN --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  int Scan(K&& sendbuf, K&& recvbuf, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::scan, -1, -1, SIZE * sizeof(T));
+		return EMPI_SCAN(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),op,communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Scan(K&& sendbuf, K&& recvbuf, int size, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::scan, -1, -1, size * sizeof(T));
+		return EMPI_SCAN(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),op,communicator);
+	  }
+
+	  // ------------------------- END SCAN --------------------------
+	  // ------------------------- EXSCAN --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  int Exscan(K&& sendbuf, K&& recvbuf, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::exscan, -1, -1, SIZE * sizeof(T));
+		return EMPI_EXSCAN(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),op,communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  int Exscan(K&& sendbuf, K&& recvbuf, int size, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::exscan, -1, -1, size * sizeof(T));
+		return EMPI_EXSCAN(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),op,communicator);
+	  }
+
+	  // ------------------------- END EXSCAN --------------------------
+	  // ------------------------- IALLREDUCE --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  async_event Iallreduce(K&& sendbuf, K&& recvbuf, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::iallreduce, -1, -1, SIZE * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IALLREDUCE(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),op,communicator, event.get_request());
+		return event;
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  async_event Iallreduce(K&& sendbuf, K&& recvbuf, int size, MPI_Op op){
+		EMPI_TRACE_SCOPE(details::mpi_function::iallreduce, -1, -1, size * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IALLREDUCE(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),op,communicator, event.get_request());
+		return event;
+	  }
+
+	  template<typename K, typename F>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0) && reduction<F,T>
+	  async_event Iallreduce(K&& sendbuf, K&& recvbuf, F&& op){
+		return Iallreduce(std::forward<K>(sendbuf), std::forward<K>(recvbuf), make_op<T>(op));
+	  }
+
+	  template<typename K, typename F>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE) && reduction<F,T>
+	  async_event Iallreduce(K&& sendbuf, K&& recvbuf, int size, F&& op){
+		return Iallreduce(std::forward<K>(sendbuf), std::forward<K>(recvbuf), size, make_op<T>(op));
+	  }
+
+	  // ------------------------- END IALLREDUCE --------------------------
+	  // ------------------------- IREDUCE --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  async_event Ireduce(K&& sendbuf, K&& recvbuf, MPI_Op op, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::ireduce, root, -1, SIZE * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IREDUCE(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),op,root,communicator, event.get_request());
+		return event;
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  async_event Ireduce(K&& sendbuf, K&& recvbuf, int size, MPI_Op op, int root){
+		EMPI_TRACE_SCOPE(details::mpi_function::ireduce, root, -1, size * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IREDUCE(details::get_underlying_pointer(sendbuf),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),op,root,communicator, event.get_request());
+		return event;
+	  }
+
+	  // ------------------------- END IREDUCE --------------------------
+	  // ------------------------- PERSISTENT COLLECTIVES --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  persistent_collective Allreduce_init(K&& sendbuf, K&& recvbuf, MPI_Op op){
+		return persistent_collective(persistent_collective::kind::allreduce, details::get_underlying_pointer(sendbuf), details::get_underlying_pointer(recvbuf), SIZE, details::mpi_type<T>::get_type(), op, 0, communicator, _request_pool);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  persistent_collective Allreduce_init(K&& sendbuf, K&& recvbuf, int size, MPI_Op op){
+		return persistent_collective(persistent_collective::kind::allreduce, details::get_underlying_pointer(sendbuf), details::get_underlying_pointer(recvbuf), size, details::mpi_type<T>::get_type(), op, 0, communicator, _request_pool);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  persistent_collective Bcast_init(K&& data, int root){
+		return persistent_collective(persistent_collective::kind::bcast, nullptr, details::get_underlying_pointer(data), SIZE, details::mpi_type<T>::get_type(), MPI_OP_NULL, root, communicator, _request_pool);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  persistent_collective Bcast_init(K&& data, int root, int size){
+		return persistent_collective(persistent_collective::kind::bcast, nullptr, details::get_underlying_pointer(data), size, details::mpi_type<T>::get_type(), MPI_OP_NULL, root, communicator, _request_pool);
+	  }
+
+	  // ------------------------- END PERSISTENT COLLECTIVES --------------------------
 	  // ------------------------- GATHERV --------------------------
 	template<typename K>
 	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>)
 	  int gatherv(int root, K&& sendbuf,int sendcount, K&& recvbuf, int* recvcounts, int* displacements){
+		EMPI_TRACE_SCOPE(details::mpi_function::gatherv, root, -1, sendcount * sizeof(T));
 		return EMPI_GATHERV(details::get_underlying_pointer(sendbuf), 
 						   sendcount,
 						   details::mpi_type<T>::get_type(),
@@ -255,12 +740,105 @@ namespace empi{
 						   root,
 						   communicator);
 	  }
-	  // ------------------------- END ALLREDUCE --------------------------
+	  // ------------------------- END GATHERV --------------------------
+	  // ------------------------- IGATHERV --------------------------
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>)
+	  async_event Igatherv(int root, K&& sendbuf,int sendcount, K&& recvbuf, int* recvcounts, int* displacements){
+		EMPI_TRACE_SCOPE(details::mpi_function::igatherv, root, -1, sendcount * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IGATHERV(details::get_underlying_pointer(sendbuf),
+								  sendcount,
+								  details::mpi_type<T>::get_type(),
+								  details::get_underlying_pointer(recvbuf),
+								  recvcounts,
+								  displacements,
+								  details::mpi_type<T>::get_type(),
+								  root,
+								  communicator,
+								  event.get_request());
+		return event;
+	  }
+
+	  // ------------------------- END IGATHERV --------------------------
+	  // ------------------------- IALLGATHER --------------------------
+	  // SIZE (or size) is the number of elements contributed by each rank
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  async_event Iallgather(K&& sendbuf, K&& recvbuf){
+		EMPI_TRACE_SCOPE(details::mpi_function::iallgather, -1, -1, SIZE * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IALLGATHER(details::get_underlying_pointer(sendbuf),SIZE,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),communicator, event.get_request());
+		return event;
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  async_event Iallgather(K&& sendbuf, K&& recvbuf, int size){
+		EMPI_TRACE_SCOPE(details::mpi_function::iallgather, -1, -1, size * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IALLGATHER(details::get_underlying_pointer(sendbuf),size,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),communicator, event.get_request());
+		return event;
+	  }
+
+	  // ------------------------- END IALLGATHER --------------------------
+	  // ------------------------- IALLTOALL --------------------------
+	  // SIZE (or size) is the number of elements exchanged with each rank
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE > 0)
+	  async_event Ialltoall(K&& sendbuf, K&& recvbuf){
+		EMPI_TRACE_SCOPE(details::mpi_function::ialltoall, -1, -1, SIZE * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IALLTOALL(details::get_underlying_pointer(sendbuf),SIZE,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),SIZE,details::mpi_type<T>::get_type(),communicator, event.get_request());
+		return event;
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>) && (SIZE == NOSIZE)
+	  async_event Ialltoall(K&& sendbuf, K&& recvbuf, int size){
+		EMPI_TRACE_SCOPE(details::mpi_function::ialltoall, -1, -1, size * sizeof(T));
+		auto event = _request_pool->get_req();
+		event.res = EMPI_IALLTOALL(details::get_underlying_pointer(sendbuf),size,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),size,details::mpi_type<T>::get_type(),communicator, event.get_request());
+		return event;
+	  }
+
+	  // ------------------------- END IALLTOALL --------------------------
+	  // ------------------------- NEIGHBOR_ALLTOALLV --------------------------
+	  // Requires a communicator with a process topology: block i of sendbuf goes to
+	  // the i-th destination, block i of recvbuf comes from the i-th source
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>)
+	  int Neighbor_alltoallv(K&& sendbuf, const int* sendcounts, const int* sdispls, K&& recvbuf, const int* recvcounts, const int* rdispls){
+		EMPI_TRACE_SCOPE(details::mpi_function::neighbor_alltoallv, -1, -1, 0);
+		return EMPI_NEIGHBOR_ALLTOALLV(details::get_underlying_pointer(sendbuf),sendcounts,sdispls,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),recvcounts,rdispls,details::mpi_type<T>::get_type(),communicator);
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>)
+	  async_event Ineighbor_alltoallv(K&& sendbuf, const int* sendcounts, const int* sdispls, K&& recvbuf, const int* recvcounts, const int* rdispls){
+		EMPI_TRACE_SCOPE(details::mpi_function::ineighbor_alltoallv, -1, -1, 0);
+		auto event = _request_pool->get_req();
+		event.res = EMPI_INEIGHBOR_ALLTOALLV(details::get_underlying_pointer(sendbuf),sendcounts,sdispls,details::mpi_type<T>::get_type(),details::get_underlying_pointer(recvbuf),recvcounts,rdispls,details::mpi_type<T>::get_type(),communicator, event.get_request());
+		return event;
+	  }
+
+	  template<typename K>
+	  requires (is_valid_container<T,K> || is_valid_pointer<T,K>)
+	  persistent_collective Neighbor_alltoallv_init(K&& sendbuf, const int* sendcounts, const int* sdispls, K&& recvbuf, const int* recvcounts, const int* rdispls){
+		return persistent_collective(details::get_underlying_pointer(sendbuf), sendcounts, sdispls, details::get_underlying_pointer(recvbuf), recvcounts, rdispls, details::mpi_type<T>::get_type(), communicator, _request_pool);
+	  }
+
+	  // ------------------------- END NEIGHBOR_ALLTOALLV --------------------------
 
 
 		private:
 			MPI_Comm communicator;
 			std::shared_ptr<request_pool> _request_pool;
+			details::collective_policy* collectives; // Set when the group has a collective table or tuning
 			int max_tag;
 	};
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_OP_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_OP_HPP_
+
+#include <concepts>
+#include <mpi.h>
+#include <type_traits>
+
+namespace empi {
+
+// Stateless callable combining two T into a T, usable as a reduction instead of an MPI_Op
+template<typename F, typename T>
+concept reduction = !std::is_convertible_v<std::remove_cvref_t<F>, MPI_Op> && std::is_empty_v<std::remove_cvref_t<F>> &&
+    std::default_initializable<std::remove_cvref_t<F>> && requires(const std::remove_cvref_t<F> f, const T a, const T b) {
+        { f(a, b) } -> std::convertible_to<T>;
+    };
+
+// Marks a stateless reduction as non commutative, reductions are commutative by default:
+//
+//     mgh.Allreduce(send, recv, n, empi::non_commutative([](auto a, auto b) { return a * b; }))
+//
+// MPI then combines the contributions in rank order, and the collective policies
+// never route it to the hierarchical or ring algorithms.
+template<typename F>
+struct non_commutative : F {
+    constexpr non_commutative() = default;
+    constexpr explicit non_commutative(F f) : F(f) {}
+};
+
+template<typename F>
+non_commutative(F) -> non_commutative<F>;
+
+namespace details {
+
+template<typename F>
+inline constexpr bool is_non_commutative_v = false;
+
+template<typename F>
+inline constexpr bool is_non_commutative_v<non_commutative<F>> = true;
+
+// MPI_User_function for F over T. F is stateless, so the trampoline rebuilds it
+// instead of reaching for a capture; the loop has no aliasing and no calls left
+// after inlining and is vectorized over T when T is arithmetic.
+// MPI defines the result as inoutvec[i] = invec[i] op inoutvec[i].
+template<typename T, typename F, bool commutative>
+struct reduction_trampoline {
+    static void apply(void *invec, void *inoutvec, int *len, MPI_Datatype *) {
+        const T *__restrict in = static_cast<const T *>(invec);
+        T *__restrict inout = static_cast<T *>(inoutvec);
+        const F f{};
+        const int n = *len;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC ivdep
+#endif
+        for(int i = 0; i < n; i++) inout[i] = f(in[i], inout[i]);
+    }
+
+    // Created on first use and kept for the whole process lifetime, like the aggregate datatypes
+    static MPI_Op get() {
+        static const MPI_Op op = [] {
+            MPI_Op created;
+            MPI_Op_create(&apply, commutative, &created);
+            return created;
+        }();
+        return op;
+    }
+};
+
+} // namespace details
+
+// MPI_Op applying f elementwise on T, one per (T, F, commutative).
+// Commutative unless the flag is false or f is wrapped in non_commutative.
+template<typename T, bool commutative = true, typename F>
+    requires reduction<F, T>
+MPI_Op make_op(F &&) {
+    using G = std::remove_cvref_t<F>;
+    return details::reduction_trampoline<T, G, commutative && !details::is_non_commutative_v<G>>::get();
+}
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_OP_HPP_
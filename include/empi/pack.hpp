@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_PACK_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_PACK_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <empi/view.hpp>
+
+#if(defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define EMPI_HAS_X86_DISPATCH 1
+#include <immintrin.h>
+#else
+#define EMPI_HAS_X86_DISPATCH 0
+#endif
+
+namespace empi {
+
+// Pack/unpack of count blocks of blocklength elements, stride elements apart,
+// to and from a contiguous staging buffer. 4 and 8 byte elements use AVX2 or
+// AVX-512 kernels (gathers/scatters for single-element blocks, wide copies
+// otherwise) selected once at runtime from the CPU features; every other case,
+// and non-x86 targets, use the scalar kernels.
+enum class simd_isa { scalar, avx2, avx512 };
+
+namespace details {
+
+inline simd_isa detect_isa() {
+#if EMPI_HAS_X86_DISPATCH
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) return simd_isa::avx512;
+    if(__builtin_cpu_supports("avx2")) return simd_isa::avx2;
+#endif
+    return simd_isa::scalar;
+}
+
+// ------------------------- SCALAR --------------------------
+
+template<std::size_t E>
+void pack_scalar(const char *src, char *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        for(std::size_t c = 0; c < count; c++) std::memcpy(dst + c * E, src + c * stride * E, E);
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++)
+        std::memcpy(dst + c * blocklength * E, src + c * stride * E, blocklength * E);
+}
+
+template<std::size_t E>
+void unpack_scalar(const char *src, char *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        for(std::size_t c = 0; c < count; c++) std::memcpy(dst + c * stride * E, src + c * E, E);
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++)
+        std::memcpy(dst + c * stride * E, src + c * blocklength * E, blocklength * E);
+}
+
+template<typename T>
+void unpack_add_scalar(const T *src, T *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    for(std::size_t c = 0; c < count; c++)
+        for(std::size_t b = 0; b < blocklength; b++) dst[c * stride + b] += src[c * blocklength + b];
+}
+
+// ------------------------- END SCALAR --------------------------
+#if EMPI_HAS_X86_DISPATCH
+// ------------------------- AVX2 --------------------------
+// 8 byte elements are moved as double and 4 byte elements as float: loads,
+// stores, gathers and scatters copy the bits unchanged.
+
+__attribute__((target("avx2"))) inline void copy_avx2(const double *s, double *d, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) _mm256_storeu_pd(d + i, _mm256_loadu_pd(s + i));
+    std::memcpy(d + i, s + i, (n - i) * sizeof(double));
+}
+
+__attribute__((target("avx2"))) inline void copy_avx2(const float *s, float *d, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) _mm256_storeu_ps(d + i, _mm256_loadu_ps(s + i));
+    std::memcpy(d + i, s + i, (n - i) * sizeof(float));
+}
+
+__attribute__((target("avx2"))) inline void pack_avx2(
+    const double *src, double *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        const __m256i index = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+        std::size_t c = 0;
+        for(; c + 4 <= count; c += 4)
+            _mm256_storeu_pd(dst + c, _mm256_i64gather_pd(src + c * stride, index, sizeof(double)));
+        for(; c < count; c++) std::memcpy(dst + c, src + c * stride, sizeof(double));
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) copy_avx2(src + c * stride, dst + c * blocklength, blocklength);
+}
+
+__attribute__((target("avx2"))) inline void pack_avx2(
+    const float *src, float *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        const __m256i index = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+        std::size_t c = 0;
+        for(; c + 4 <= count; c += 4)
+            _mm_storeu_ps(dst + c, _mm256_i64gather_ps(src + c * stride, index, sizeof(float)));
+        for(; c < count; c++) std::memcpy(dst + c, src + c * stride, sizeof(float));
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) copy_avx2(src + c * stride, dst + c * blocklength, blocklength);
+}
+
+// AVX2 has no scatter: single-element blocks are stored one by one
+template<typename T>
+__attribute__((target("avx2"))) inline void unpack_avx2(
+    const T *src, T *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        unpack_scalar<sizeof(T)>(reinterpret_cast<const char *>(src), reinterpret_cast<char *>(dst), count, 1, stride);
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) copy_avx2(src + c * blocklength, dst + c * stride, blocklength);
+}
+
+__attribute__((target("avx2"))) inline void unpack_add_avx2(
+    const double *src, double *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength < 4) {
+        unpack_add_scalar(src, dst, count, blocklength, stride);
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) {
+        const double *s = src + c * blocklength;
+        double *d = dst + c * stride;
+        std::size_t i = 0;
+        for(; i + 4 <= blocklength; i += 4)
+            _mm256_storeu_pd(d + i, _mm256_add_pd(_mm256_loadu_pd(d + i), _mm256_loadu_pd(s + i)));
+        for(; i < blocklength; i++) d[i] += s[i];
+    }
+}
+
+__attribute__((target("avx2"))) inline void unpack_add_avx2(
+    const float *src, float *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength < 8) {
+        unpack_add_scalar(src, dst, count, blocklength, stride);
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) {
+        const float *s = src + c * blocklength;
+        float *d = dst + c * stride;
+        std::size_t i = 0;
+        for(; i + 8 <= blocklength; i += 8)
+            _mm256_storeu_ps(d + i, _mm256_add_ps(_mm256_loadu_ps(d + i), _mm256_loadu_ps(s + i)));
+        for(; i < blocklength; i++) d[i] += s[i];
+    }
+}
+
+// ------------------------- END AVX2 --------------------------
+// ------------------------- AVX-512 --------------------------
+
+__attribute__((target("avx512f"))) inline void copy_avx512(const double *s, double *d, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) _mm512_storeu_pd(d + i, _mm512_loadu_pd(s + i));
+    if(i < n) {
+        const __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+        _mm512_mask_storeu_pd(d + i, mask, _mm512_maskz_loadu_pd(mask, s + i));
+    }
+}
+
+__attribute__((target("avx512f"))) inline void copy_avx512(const float *s, float *d, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 16 <= n; i += 16) _mm512_storeu_ps(d + i, _mm512_loadu_ps(s + i));
+    if(i < n) {
+        const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+        _mm512_mask_storeu_ps(d + i, mask, _mm512_maskz_loadu_ps(mask, s + i));
+    }
+}
+
+__attribute__((target("avx512f"))) inline __m512i lane_offsets(std::ptrdiff_t stride) {
+    return _mm512_set_epi64(7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride, stride, 0);
+}
+
+// Full-mask gathers: the unmasked intrinsics trip -Wmaybe-uninitialized on GCC
+__attribute__((target("avx512f"))) inline __m512d gather_avx512(__m512i index, const double *base) {
+    return _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, index, base, sizeof(double));
+}
+
+__attribute__((target("avx512f"))) inline __m256 gather_avx512(__m512i index, const float *base) {
+    return _mm512_mask_i64gather_ps(_mm256_setzero_ps(), 0xFF, index, base, sizeof(float));
+}
+
+__attribute__((target("avx512f"))) inline void pack_avx512(
+    const double *src, double *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        const __m512i index = lane_offsets(stride);
+        std::size_t c = 0;
+        for(; c + 8 <= count; c += 8)
+            _mm512_storeu_pd(dst + c, gather_avx512(index, src + c * stride));
+        for(; c < count; c++) std::memcpy(dst + c, src + c * stride, sizeof(double));
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) copy_avx512(src + c * stride, dst + c * blocklength, blocklength);
+}
+
+__attribute__((target("avx512f"))) inline void pack_avx512(
+    const float *src, float *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        const __m512i index = lane_offsets(stride);
+        std::size_t c = 0;
+        for(; c + 8 <= count; c += 8)
+            _mm256_storeu_ps(dst + c, gather_avx512(index, src + c * stride));
+        for(; c < count; c++) std::memcpy(dst + c, src + c * stride, sizeof(float));
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) copy_avx512(src + c * stride, dst + c * blocklength, blocklength);
+}
+
+__attribute__((target("avx512f"))) inline void unpack_avx512(
+    const double *src, double *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        const __m512i index = lane_offsets(stride);
+        std::size_t c = 0;
+        for(; c + 8 <= count; c += 8)
+            _mm512_i64scatter_pd(dst + c * stride, index, _mm512_loadu_pd(src + c), sizeof(double));
+        for(; c < count; c++) std::memcpy(dst + c * stride, src + c, sizeof(double));
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) copy_avx512(src + c * blocklength, dst + c * stride, blocklength);
+}
+
+__attribute__((target("avx512f"))) inline void unpack_avx512(
+    const float *src, float *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        const __m512i index = lane_offsets(stride);
+        std::size_t c = 0;
+        for(; c + 8 <= count; c += 8)
+            _mm512_i64scatter_ps(dst + c * stride, index, _mm256_loadu_ps(src + c), sizeof(float));
+        for(; c < count; c++) std::memcpy(dst + c * stride, src + c, sizeof(float));
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) copy_avx512(src + c * blocklength, dst + c * stride, blocklength);
+}
+
+__attribute__((target("avx512f"))) inline void unpack_add_avx512(
+    const double *src, double *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        const __m512i index = lane_offsets(stride);
+        std::size_t c = 0;
+        for(; c + 8 <= count; c += 8) {
+            double *d = dst + c * stride;
+            const __m512d sum = _mm512_add_pd(gather_avx512(index, d), _mm512_loadu_pd(src + c));
+            _mm512_i64scatter_pd(d, index, sum, sizeof(double));
+        }
+        for(; c < count; c++) dst[c * stride] += src[c];
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) {
+        const double *s = src + c * blocklength;
+        double *d = dst + c * stride;
+        std::size_t i = 0;
+        for(; i + 8 <= blocklength; i += 8)
+            _mm512_storeu_pd(d + i, _mm512_add_pd(_mm512_loadu_pd(d + i), _mm512_loadu_pd(s + i)));
+        for(; i < blocklength; i++) d[i] += s[i];
+    }
+}
+
+__attribute__((target("avx512f"))) inline void unpack_add_avx512(
+    const float *src, float *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(blocklength == 1) {
+        const __m512i index = lane_offsets(stride);
+        std::size_t c = 0;
+        for(; c + 8 <= count; c += 8) {
+            float *d = dst + c * stride;
+            const __m256 sum = _mm256_add_ps(gather_avx512(index, d), _mm256_loadu_ps(src + c));
+            _mm512_i64scatter_ps(d, index, sum, sizeof(float));
+        }
+        for(; c < count; c++) dst[c * stride] += src[c];
+        return;
+    }
+    for(std::size_t c = 0; c < count; c++) {
+        const float *s = src + c * blocklength;
+        float *d = dst + c * stride;
+        std::size_t i = 0;
+        for(; i + 16 <= blocklength; i += 16)
+            _mm512_storeu_ps(d + i, _mm512_add_ps(_mm512_loadu_ps(d + i), _mm512_loadu_ps(s + i)));
+        for(; i < blocklength; i++) d[i] += s[i];
+    }
+}
+
+// ------------------------- END AVX-512 --------------------------
+#endif
+
+// Element type the SIMD kernels move T as, void when T has no SIMD kernel
+template<typename T>
+using simd_lane_t = std::conditional_t<sizeof(T) == 8, double, std::conditional_t<sizeof(T) == 4, float, void>>;
+
+template<typename T>
+void pack_with(
+    simd_isa isa, const T *src, T *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(stride == static_cast<std::ptrdiff_t>(blocklength)) {
+        std::memcpy(dst, src, count * blocklength * sizeof(T));
+        return;
+    }
+#if EMPI_HAS_X86_DISPATCH
+    using L = simd_lane_t<T>;
+    if constexpr(!std::is_void_v<L>) {
+        const auto *s = reinterpret_cast<const L *>(src);
+        auto *d = reinterpret_cast<L *>(dst);
+        switch(isa) {
+            case simd_isa::avx512: return pack_avx512(s, d, count, blocklength, stride);
+            case simd_isa::avx2: return pack_avx2(s, d, count, blocklength, stride);
+            case simd_isa::scalar: break;
+        }
+    }
+#endif
+    pack_scalar<sizeof(T)>(reinterpret_cast<const char *>(src), reinterpret_cast<char *>(dst), count, blocklength,
+        stride);
+}
+
+template<typename T>
+void unpack_with(
+    simd_isa isa, const T *src, T *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    if(stride == static_cast<std::ptrdiff_t>(blocklength)) {
+        std::memcpy(dst, src, count * blocklength * sizeof(T));
+        return;
+    }
+#if EMPI_HAS_X86_DISPATCH
+    using L = simd_lane_t<T>;
+    if constexpr(!std::is_void_v<L>) {
+        const auto *s = reinterpret_cast<const L *>(src);
+        auto *d = reinterpret_cast<L *>(dst);
+        switch(isa) {
+            case simd_isa::avx512: return unpack_avx512(s, d, count, blocklength, stride);
+            case simd_isa::avx2: return unpack_avx2(s, d, count, blocklength, stride);
+            case simd_isa::scalar: break;
+        }
+    }
+#endif
+    unpack_scalar<sizeof(T)>(reinterpret_cast<const char *>(src), reinterpret_cast<char *>(dst), count, blocklength,
+        stride);
+}
+
+template<typename T>
+void unpack_add_with(
+    simd_isa isa, const T *src, T *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+#if EMPI_HAS_X86_DISPATCH
+    if constexpr(std::is_same_v<T, double> || std::is_same_v<T, float>) {
+        switch(isa) {
+            case simd_isa::avx512: return unpack_add_avx512(src, dst, count, blocklength, stride);
+            case simd_isa::avx2: return unpack_add_avx2(src, dst, count, blocklength, stride);
+            case simd_isa::scalar: break;
+        }
+    }
+#endif
+    unpack_add_scalar(src, dst, count, blocklength, stride);
+}
+
+} // namespace details
+
+// Best instruction set supported by this CPU, detected once
+inline simd_isa simd_level() {
+    static const simd_isa isa = details::detect_isa();
+    return isa;
+}
+
+// Gather count blocks of blocklength elements, stride elements apart, into contiguous dst
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+void pack(const T *src, T *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    details::pack_with(simd_level(), src, dst, count, blocklength, stride);
+}
+
+// Scatter contiguous src into count blocks of blocklength elements, stride elements apart
+template<typename T>
+    requires std::is_trivially_copyable_v<T>
+void unpack(const T *src, T *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    details::unpack_with(simd_level(), src, dst, count, blocklength, stride);
+}
+
+// Like unpack, but adds src to the values already in dst
+template<typename T>
+    requires std::is_arithmetic_v<T>
+void unpack_add(const T *src, T *dst, std::size_t count, std::size_t blocklength, std::ptrdiff_t stride) {
+    details::unpack_add_with(simd_level(), src, dst, count, blocklength, stride);
+}
+
+// Pack a whole strided view into dst; returns one past the last element written.
+// The innermost dimension is the block, every outer index is visited in order.
+template<typename T, std::size_t N>
+T *pack(const strided_view<T, N> &v, std::remove_const_t<T> *dst) {
+    if constexpr(N == 1) {
+        pack<std::remove_const_t<T>>(v.base, dst, v.extents[0], 1, v.strides[0]);
+        return dst + v.extents[0];
+    } else if constexpr(N == 2) {
+        if(v.strides[1] == 1) {
+            pack<std::remove_const_t<T>>(v.base, dst, v.extents[0], v.extents[1], v.strides[0]);
+            return dst + v.extents[0] * v.extents[1];
+        }
+        for(int i = 0; i < v.extents[0]; i++)
+            dst = pack(strided(v.base + i * v.strides[0], v.extents[1], v.strides[1]), dst);
+        return dst;
+    } else {
+        strided_view<T, N - 1> inner{v.base, {}, {}};
+        for(std::size_t d = 1; d < N; d++) {
+            inner.extents[d - 1] = v.extents[d];
+            inner.strides[d - 1] = v.strides[d];
+        }
+        for(int i = 0; i < v.extents[0]; i++) {
+            inner.base = v.base + i * v.strides[0];
+            dst = pack(inner, dst);
+        }
+        return dst;
+    }
+}
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_PACK_HPP_
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef INCLUDE_EMPI_PERSISTENT
+#define INCLUDE_EMPI_PERSISTENT
+
+#include <empi/async_event.hpp>
+#include <empi/datatype.hpp>
+#include <empi/defines.hpp>
+#include <empi/request_pool.hpp>
+#include <memory>
+#include <mpi.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace empi {
+
+// Owner of a persistent request created by MPI_Send_init/MPI_Recv_init.
+// Buffer, peer, count, type and tag are bound once, each start() only
+// re-activates the request. The request is freed on destruction.
+class persistent_channel {
+  public:
+    persistent_channel() : request(MPI_REQUEST_NULL), res(-1) {}
+
+    persistent_channel(const persistent_channel &) = delete;
+    persistent_channel &operator=(const persistent_channel &) = delete;
+
+    persistent_channel(persistent_channel &&other) noexcept
+        : request(std::exchange(other.request, MPI_REQUEST_NULL)), res(other.res) {}
+
+    persistent_channel &operator=(persistent_channel &&other) noexcept {
+        if(this != &other) {
+            free();
+            request = std::exchange(other.request, MPI_REQUEST_NULL);
+            res = other.res;
+        }
+        return *this;
+    }
+
+    ~persistent_channel() { free(); }
+
+    int start() { return MPI_Start(&request); }
+
+    [[nodiscard]] MPI_Status wait() {
+        MPI_Status mpi_status;
+        MPI_Wait(&request, &mpi_status);
+        return mpi_status;
+    }
+
+    template<bool status>
+        requires(status == empi::details::no_status)
+    void wait() {
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+    }
+
+    bool test() {
+        int flag = 0;
+        MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+        return flag;
+    }
+
+    [[nodiscard]] auto get_request() -> MPI_Request * { return &request; }
+
+    // Give up ownership, used by channel_set to gather the requests
+    [[nodiscard]] MPI_Request release() { return std::exchange(request, MPI_REQUEST_NULL); }
+
+  private:
+    void free() {
+        if(request != MPI_REQUEST_NULL) MPI_Request_free(&request);
+    }
+
+    MPI_Request request;
+
+  public:
+    int res;
+};
+
+// A group of persistent channels stored in one contiguous MPI_Request
+// array, started with a single MPI_Startall and completed with MPI_Waitall.
+class channel_set {
+  public:
+    channel_set() = default;
+
+    channel_set(const channel_set &) = delete;
+    channel_set &operator=(const channel_set &) = delete;
+    channel_set(channel_set &&) noexcept = default;
+    channel_set &operator=(channel_set &&other) noexcept {
+        std::swap(requests, other.requests);
+        return *this;
+    }
+
+    ~channel_set() {
+        for(auto &request : requests)
+            if(request != MPI_REQUEST_NULL) MPI_Request_free(&request);
+    }
+
+    channel_set &add(persistent_channel &&channel) {
+        if(channel.res != MPI_SUCCESS) throw std::runtime_error("Adding an uninitialized channel to a channel_set");
+        requests.push_back(channel.release());
+        return *this;
+    }
+
+    int startall() { return MPI_Startall(static_cast<int>(requests.size()), requests.data()); }
+
+    int waitall() { return MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE); }
+
+    bool testall() {
+        int flag = 0;
+        MPI_Testall(static_cast<int>(requests.size()), requests.data(), &flag, MPI_STATUSES_IGNORE);
+        return flag;
+    }
+
+    [[nodiscard]] size_t size() const { return requests.size(); }
+
+  private:
+    std::vector<MPI_Request> requests;
+};
+
+// Collective whose schedule is built once and restarted many times.
+// With persistent collective support it wraps an MPI_Allreduce_init/MPI_Bcast_init/
+// MPI_Neighbor_alltoallv_init request; otherwise it keeps the bound arguments and
+// replays the nonblocking collective on every start(). Each start() is registered
+// in the request_pool, so waitall on the pool also completes the collective.
+// Counts and displacements are bound by pointer and must outlive the collective.
+class persistent_collective {
+  public:
+    enum class kind { allreduce, bcast, neighbor_alltoallv };
+
+    persistent_collective(kind k, const void *sendbuf, void *recvbuf, int count, MPI_Datatype type, MPI_Op op,
+        int root, MPI_Comm comm, std::shared_ptr<request_pool> pool)
+        : k(k), sendbuf(sendbuf), recvbuf(recvbuf), count(count), type(type), op(op), root(root), comm(comm),
+          pool(std::move(pool)), request(MPI_REQUEST_NULL), res(MPI_SUCCESS) {
+        // Counts and displacements have no place here: a neighbor_alltoallv needs the other constructor
+        if(k == kind::neighbor_alltoallv)
+            throw std::invalid_argument("persistent_collective: neighbor_alltoallv needs counts and displacements");
+#if EMPI_HAS_PERSISTENT_COLLECTIVES
+        switch(k) {
+            case kind::allreduce:
+                res = EMPI_ALLREDUCE_INIT(sendbuf, recvbuf, count, type, op, comm, MPI_INFO_NULL, &request);
+                break;
+            case kind::bcast: res = EMPI_BCAST_INIT(recvbuf, count, type, root, comm, MPI_INFO_NULL, &request); break;
+            case kind::neighbor_alltoallv: break; // Rejected above
+        }
+#endif
+    }
+
+    persistent_collective(const void *sendbuf, const int *sendcounts, const int *sdispls, void *recvbuf,
+        const int *recvcounts, const int *rdispls, MPI_Datatype type, MPI_Comm comm, std::shared_ptr<request_pool> pool)
+        : k(kind::neighbor_alltoallv), sendbuf(sendbuf), recvbuf(recvbuf), count(0), type(type), op(MPI_OP_NULL),
+          root(0), comm(comm), sendcounts(sendcounts), sdispls(sdispls), recvcounts(recvcounts), rdispls(rdispls),
+          pool(std::move(pool)), request(MPI_REQUEST_NULL), res(MPI_SUCCESS) {
+#if EMPI_HAS_PERSISTENT_COLLECTIVES
+        res = EMPI_NEIGHBOR_ALLTOALLV_INIT(sendbuf, sendcounts, sdispls, type, recvbuf, recvcounts, rdispls, type, comm,
+            MPI_INFO_NULL, &request);
+#endif
+    }
+
+    persistent_collective(const persistent_collective &) = delete;
+    persistent_collective &operator=(const persistent_collective &) = delete;
+
+    persistent_collective(persistent_collective &&other) noexcept
+        : k(other.k), sendbuf(other.sendbuf), recvbuf(other.recvbuf), count(other.count), type(other.type),
+          op(other.op), root(other.root), comm(other.comm), sendcounts(other.sendcounts), sdispls(other.sdispls),
+          recvcounts(other.recvcounts), rdispls(other.rdispls), pool(std::move(other.pool)),
+          request(std::exchange(other.request, MPI_REQUEST_NULL)), event(std::exchange(other.event, async_event{})),
+          res(other.res) {}
+
+    persistent_collective &operator=(persistent_collective &&) = delete;
+
+    ~persistent_collective() {
+        if(!pool) return;
+        wait<details::no_status>();
+        if(request != MPI_REQUEST_NULL) MPI_Request_free(&request);
+    }
+
+    async_event start() {
+        event = pool->get_req();
+#if EMPI_HAS_PERSISTENT_COLLECTIVES
+        event.res = MPI_Start(&request);
+        *event.get_request() = request;
+#else
+        switch(k) {
+            case kind::allreduce:
+                event.res = EMPI_IALLREDUCE(sendbuf, recvbuf, count, type, op, comm, event.get_request());
+                break;
+            case kind::bcast: event.res = EMPI_IBCAST(recvbuf, count, type, root, comm, event.get_request()); break;
+            case kind::neighbor_alltoallv:
+                event.res = EMPI_INEIGHBOR_ALLTOALLV(sendbuf, sendcounts, sdispls, type, recvbuf, recvcounts, rdispls,
+                    type, comm, event.get_request());
+                break;
+        }
+#endif
+        return event;
+    }
+
+    template<bool status>
+        requires(status == empi::details::no_status)
+    void wait() {
+#if EMPI_HAS_PERSISTENT_COLLECTIVES
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        // The pool holds a copy of the request: drop it now that it is inactive
+        if(auto *copy = event.get_request()) *copy = MPI_REQUEST_NULL;
+#else
+        event.wait<details::no_status>();
+#endif
+    }
+
+    // Start and complete in one call, like the blocking collective
+    int operator()() {
+        start();
+        wait<details::no_status>();
+        return event.res;
+    }
+
+  private:
+    kind k;
+    const void *sendbuf;
+    void *recvbuf;
+    int count;
+    MPI_Datatype type;
+    MPI_Op op;
+    int root;
+    MPI_Comm comm;
+    const int *sendcounts = nullptr;
+    const int *sdispls = nullptr;
+    const int *recvcounts = nullptr;
+    const int *rdispls = nullptr;
+    std::shared_ptr<request_pool> pool;
+    MPI_Request request;
+    async_event event;
+
+  public:
+    int res;
+};
+
+} // namespace empi
+
+#endif /* INCLUDE_EMPI_PERSISTENT */
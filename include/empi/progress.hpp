@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_PROGRESS_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_PROGRESS_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mpi.h>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace empi {
+
+// Progress thread settings, see Context::start_progress
+struct progress_options {
+    int core = -1;                            // Core the thread is pinned to, -1 leaves it to the OS
+    std::chrono::microseconds min_backoff{0}; // Pause after a poll with no new request (0 yields)
+    std::chrono::microseconds max_backoff{50}; // The pause doubles up to this while nothing is posted
+};
+
+namespace details {
+
+// Raised by the request pools on every post, cleared by the progress thread to
+// reset its backoff. Once raised only the progress thread writes it, so posting
+// threads mostly read a shared cache line.
+struct progress_signal {
+    void notify() {
+        if(!posted.load(std::memory_order_relaxed)) posted.store(true, std::memory_order_relaxed);
+    }
+
+    bool consume() { return posted.exchange(false, std::memory_order_relaxed); }
+
+    std::atomic<bool> posted{false};
+};
+
+// Thread entering the MPI library in a loop, so outstanding requests (e.g. the
+// rendezvous of a large Isend) advance while the application computes.
+// It polls with MPI_Testsome a receive of its own on a private communicator
+// rather than the pool requests: a request_ring is owned by the posting thread
+// and a request must not be completed by two threads at once. Stopping sends
+// the message that completes that receive.
+class progress_engine {
+  public:
+    progress_engine(progress_options options, std::shared_ptr<progress_signal> signal) : signal(std::move(signal)) {
+        MPI_Comm_dup(MPI_COMM_SELF, &comm);
+        MPI_Irecv(nullptr, 0, MPI_BYTE, 0, 0, comm, &wake);
+        thread = std::thread([this, options] { run(options); });
+    }
+
+    progress_engine(const progress_engine &) = delete;
+    progress_engine &operator=(const progress_engine &) = delete;
+
+    ~progress_engine() {
+        MPI_Send(nullptr, 0, MPI_BYTE, 0, 0, comm);
+        thread.join();
+        MPI_Comm_free(&comm);
+    }
+
+  private:
+    void run(progress_options options) {
+#ifdef __linux__
+        if(options.core >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(options.core, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+#endif
+        auto backoff = options.min_backoff;
+        for(;;) {
+            int completed, index;
+            MPI_Testsome(1, &wake, &completed, &index, MPI_STATUSES_IGNORE);
+            if(completed > 0) return;
+            if(signal->consume()) {
+                backoff = options.min_backoff;
+                continue;
+            }
+            if(backoff.count() == 0)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(backoff);
+            backoff = std::min(options.max_backoff, std::max(backoff * 2, std::chrono::microseconds{1}));
+        }
+    }
+
+    std::shared_ptr<progress_signal> signal;
+    MPI_Comm comm = MPI_COMM_NULL;
+    MPI_Request wake = MPI_REQUEST_NULL;
+    std::thread thread;
+};
+
+} // namespace details
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_PROGRESS_HPP_
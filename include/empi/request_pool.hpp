@@ -6,90 +6,207 @@
 #define INCLUDE_EMPI_REQUEST_POOL
 
 #include "empi/async_event.hpp"
+#include <empi/progress.hpp>
+#include <empi/request_ring.hpp>
 #include <empi/utils.hpp>
 #include "mpi.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
 #include <vector>
-#include <iostream>
 
 namespace empi {
 
-class request_pool {
-public:
-  explicit request_pool(size_t size)
-      : data(size), 
-        base_size(size),
-        window(default_windows_size) { 
-    for (auto &req : data)
-      req = std::make_shared<async_event>();
-    head = 0;
-    tail = size - 1;
+namespace details {
+
+// Shards of a request_pool. The threads owning one keep a weak reference, so
+// that a thread exiting after the pool is gone does not touch freed memory.
+struct shard_table {
+  constexpr static size_t max_shards = 256;
+
+  explicit shard_table(size_t shard_size) : shard_size(shard_size) {
+    for (auto &shard : shards)
+      shard.store(nullptr, std::memory_order_relaxed);
   }
 
-  explicit request_pool() : request_pool(default_pool_size) {}
+  shard_table(const shard_table&) = delete;
+  shard_table& operator=(const shard_table&) = delete;
 
-  std::shared_ptr<async_event>& get_req() {
-    auto& req = data.at(head);
-    head = (head + 1) % data.size();
-    if (tail == head && move_tail() == 0) {
-      // Expand
-      const size_t old_size = data.size();
-      const auto new_size = base_size * window;
-      data.resize(new_size);
-      window = window << 2;
-      auto &&end = data.begin() + static_cast<long>(new_size);
-      for (auto &&iter = data.begin() + static_cast<long>(old_size);
-           iter != end; iter++) {
-        *iter = std::make_shared<async_event>();
+  ~shard_table() {
+    for (auto &shard : shards)
+      delete shard.load(std::memory_order_relaxed);
+  }
+
+  // A shard released by an exited thread, with whatever it still has pending,
+  // or a new one
+  std::pair<size_t, request_ring*> acquire() {
+    {
+      std::lock_guard lock(mutex);
+      if (!released.empty()) {
+        const size_t index = released.back();
+        released.pop_back();
+        return {index, shards[index].load(std::memory_order_relaxed)};
       }
-      tail = new_size;
     }
-    return req;
+    const size_t index = num_shards.fetch_add(1, std::memory_order_relaxed);
+    if (index >= max_shards)
+      throw std::runtime_error("Too many threads posting on the same request_pool at once");
+    auto *ring = new request_ring(shard_size);
+    shards[index].store(ring, std::memory_order_release);
+    return {index, ring};
   }
 
-  void waitall(){
-    //Request pool is empty, nothing to wait
-    if(empi::details::abs(head,tail) <= 1)
-      return;
-
-    int err;
-    tail = (tail + 1) % data.size();
-    while(tail != head){
-      err = MPI_Wait(data[tail]->get_request(), MPI_STATUS_IGNORE);
-      if(err == MPI_ERR_REQUEST)
-        throw std::runtime_error("Wait on invalid request within request_pool. This should never happen");
-      tail = (tail + 1) % data.size();
-    }
-    tail--;
+  void release(size_t index) {
+    std::lock_guard lock(mutex);
+    released.push_back(index);
+  }
+
+  const size_t shard_size;
+  std::array<std::atomic<request_ring*>, max_shards> shards;
+  std::atomic<size_t> num_shards{0};
+  std::mutex mutex; // Guards released
+  std::vector<size_t> released;
+};
+
+} // namespace details
+
+// Thread-safe request pool for MPI_THREAD_MULTIPLE programs.
+// Every thread posting through the pool gets its own request_ring shard, so
+// get_req and growth never synchronize with other threads. Shards are
+// published once per thread in a fixed table with a single atomic increment,
+// and given back when the thread exits: max_shards bounds the threads posting
+// at the same time, not over the lifetime of the pool. The next thread takes
+// over the shard as is, its pending requests are still joined by waitall.
+//
+// The *_local functions only touch the calling thread's shard and may run
+// concurrently. waitall/testall/testsome/waitsome join every shard: like
+// MPI_Waitall on a shared array, they must not race with threads that are
+// still posting on this pool (call them after the parallel region).
+class request_pool {
+public:
+  explicit request_pool(size_t size) : table(std::make_shared<details::shard_table>(size)), id(next_id()) {}
+
+  explicit request_pool() : request_pool(default_pool_size) {}
+
+  request_pool(const request_pool&) = delete;
+  request_pool& operator=(const request_pool&) = delete;
+
+  async_event get_req() {
+    if (signal)
+      signal->notify();
+    auto &ring = local();
+    return {&ring, ring.acquire()};
+  }
+
+  void waitall() { for_each_shard([](details::request_ring &r) { r.waitall(); }); }
+
+  bool testall() {
+    bool done = true;
+    for_each_shard([&done](details::request_ring &r) { done = r.testall() && done; });
+    return done;
+  }
+
+  int testsome() {
+    int completed = 0;
+    for_each_shard([&completed](details::request_ring &r) { completed += r.testsome(); });
+    return completed;
   }
 
-  constexpr static size_t default_pool_size = 1000;
-  constexpr static size_t default_windows_size = 2;
+  int waitsome() {
+    int completed = testsome();
+    if (completed > 0)
+      return completed;
+    // Block on the first shard that still has pending requests
+    for_each_shard([&completed](details::request_ring &r) {
+      if (completed == 0 && r.pending() > 0)
+        completed = r.waitsome();
+    });
+    return completed;
+  }
+
+  void waitall_local() { local().waitall(); }
+
+  bool testall_local() { return local().testall(); }
+
+  int waitsome_local() { return local().waitsome(); }
+
+  [[nodiscard]] size_t pending() {
+    size_t count = 0;
+    for_each_shard([&count](details::request_ring &r) { count += r.pending(); });
+    return count;
+  }
+
+  // Wakes the Context progress thread on every post, set before the pool is used
+  void set_progress_signal(std::shared_ptr<details::progress_signal> s) { signal = std::move(s); }
+
+  constexpr static size_t default_pool_size = details::request_ring::default_ring_size;
+  constexpr static size_t max_shards = details::shard_table::max_shards;
 
 private:
 
-  auto move_tail() -> int {
-    int flag = 0;
-    int mov = 0;
-    tail = (tail + 1) % data.size();
-    while (tail != head) {
-      int err = MPI_Test(data[tail]->get_request(), &flag, MPI_STATUS_IGNORE);
-      if (err == MPI_ERR_REQUEST)
-        throw std::runtime_error("Found an invalid request while compacting the request_pool. This should never happen");
-      if(!flag)
-        break;
-      tail = (tail + 1) % data.size();
-      mov++;
+  static uint64_t next_id() {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Shards of the calling thread, released to their pools when it exits
+  struct thread_shards {
+    struct entry {
+      uint64_t id;
+      details::request_ring *ring;
+      size_t index;
+      std::weak_ptr<details::shard_table> table;
+    };
+
+    ~thread_shards() {
+      for (auto &e : entries)
+        if (auto table = e.table.lock())
+          table->release(e.index);
+    }
+
+    std::vector<entry> entries;
+  };
+
+  // Pools are identified by a unique id rather than by address, so a cache
+  // entry can never alias a pool allocated at the address of a destroyed one.
+  details::request_ring& local() {
+    thread_local thread_shards cache;
+    auto &entries = cache.entries;
+    if (!entries.empty() && entries.front().id == id) [[likely]]
+      return *entries.front().ring;
+    for (auto &entry : entries) {
+      if (entry.id == id) {
+        std::swap(entry, entries.front());
+        return *entries.front().ring;
+      }
+    }
+    // Drop the entries of destroyed pools, so a thread creating and destroying
+    // groups keeps only the live ones (their shards went away with the table)
+    std::erase_if(entries, [](const auto &entry) { return entry.table.expired(); });
+    const auto [index, ring] = table->acquire();
+    entries.push_back({id, ring, index, table});
+    std::swap(entries.back(), entries.front());
+    return *ring;
+  }
+
+  template<typename F>
+  void for_each_shard(F&& f) {
+    const size_t n = std::min(table->num_shards.load(std::memory_order_acquire), max_shards);
+    for (size_t i = 0; i < n; i++) {
+      // A shard being published has not posted any request yet
+      if (auto *ring = table->shards[i].load(std::memory_order_acquire))
+        f(*ring);
     }
-    tail--;
-    return mov;
   }
 
-  std::vector<std::shared_ptr<async_event>> data;
-  size_t head;
-  size_t tail;
-  size_t window;
-  size_t base_size;
+  std::shared_ptr<details::shard_table> table;
+  const uint64_t id;
+  std::shared_ptr<details::progress_signal> signal;
 };
 
 } // namespace empi
@@ -0,0 +1,193 @@
+/*
+* Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+*/
+
+#ifndef INCLUDE_EMPI_REQUEST_RING
+#define INCLUDE_EMPI_REQUEST_RING
+
+#include "mpi.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace empi::details {
+
+// Ring of MPI requests stored in a single contiguous MPI_Request block.
+// head and tail are monotonic tickets: the pending requests are the slots
+// [tail, head) modulo the (power of two) capacity, so any completion call
+// spans at most two contiguous ranges of the block.
+// The low bits of a ticket select the slot and the high bits act as its
+// generation; tickets[] records which ticket currently owns each slot.
+// A slot may also hold a copy of a persistent request owned elsewhere: it is
+// cleared as soon as the ring sees it complete, and never freed by the ring.
+// A ring has a single owner thread and performs no synchronization.
+class request_ring {
+public:
+  explicit request_ring(size_t size)
+      : capacity(std::bit_ceil(size > 0 ? size : default_ring_size)),
+        requests(std::make_unique<MPI_Request[]>(capacity)),
+        tickets(std::make_unique<uint64_t[]>(capacity)) {
+    for (size_t i = 0; i < capacity; i++) {
+      requests[i] = MPI_REQUEST_NULL;
+      tickets[i] = no_ticket;
+    }
+    head = 0;
+    tail = 0;
+  }
+
+  request_ring(const request_ring&) = delete;
+  request_ring& operator=(const request_ring&) = delete;
+
+  // Reserve the next slot and return its ticket
+  uint64_t acquire() {
+    if (head - tail == capacity && move_tail() == 0)
+      expand();
+    const uint64_t ticket = head++;
+    const size_t slot = ticket & (capacity - 1);
+    requests[slot] = MPI_REQUEST_NULL;
+    tickets[slot] = ticket;
+    return ticket;
+  }
+
+  // Request owned by ticket, or nullptr if its slot has been recycled
+  [[nodiscard]] MPI_Request *get(uint64_t ticket) const {
+    const size_t slot = ticket & (capacity - 1);
+    return tickets[slot] == ticket ? &requests[slot] : nullptr;
+  }
+
+  void waitall() {
+    for_each_range([](MPI_Request *first, int count) {
+      const int err = MPI_Waitall(count, first, MPI_STATUSES_IGNORE);
+      std::fill_n(first, count, MPI_REQUEST_NULL);
+      return err;
+    }, "Wait on invalid request within request_pool. This should never happen");
+    tail = head;
+  }
+
+  // Returns true when every pending request has completed
+  bool testall() {
+    bool done = true;
+    for_each_range([&done](MPI_Request *first, int count) {
+      int flag = 0;
+      const int err = MPI_Testall(count, first, &flag, MPI_STATUSES_IGNORE);
+      if (flag)
+        std::fill_n(first, count, MPI_REQUEST_NULL);
+      done = done && flag;
+      return err;
+    }, "Test on invalid request within request_pool. This should never happen");
+    compact();
+    return done;
+  }
+
+  // Returns the number of requests completed by this call, without blocking
+  int testsome() {
+    int completed = 0;
+    for_each_range([&completed](MPI_Request *first, int count) {
+      return some(MPI_Testsome, first, count, completed);
+    }, "Test on invalid request within request_pool. This should never happen");
+    compact();
+    return completed;
+  }
+
+  // Blocks until at least one pending request completes and returns how many did.
+  // Returns 0 when the ring is empty.
+  int waitsome() {
+    int completed = testsome();
+    if (completed > 0 || head == tail)
+      return completed;
+    // Nothing is ready yet: block on the oldest range first, then on the wrapped one
+    for_each_range([&completed](MPI_Request *first, int count) {
+      if (completed > 0)
+        return MPI_SUCCESS;
+      return some(MPI_Waitsome, first, count, completed);
+    }, "Wait on invalid request within request_pool. This should never happen");
+    compact();
+    return completed;
+  }
+
+  [[nodiscard]] size_t pending() const { return head - tail; }
+
+  constexpr static size_t default_ring_size = 1024;
+  constexpr static uint64_t no_ticket = ~uint64_t{0};
+
+private:
+
+  template<typename F>
+  void for_each_range(F&& f, const char *error) {
+    if (head == tail)
+      return;
+    const size_t first = tail & (capacity - 1);
+    const size_t last = head & (capacity - 1);
+    int err;
+    if (first < last) {
+      err = f(&requests[first], static_cast<int>(last - first));
+    } else {
+      // Wrapped (or full) ring: [first, capacity) followed by [0, last)
+      err = f(&requests[first], static_cast<int>(capacity - first));
+      if (err == MPI_SUCCESS && last > 0)
+        err = f(&requests[0], static_cast<int>(last));
+    }
+    if (err != MPI_SUCCESS)
+      throw std::runtime_error(error);
+  }
+
+  template<typename F>
+  static int some(F&& mpi_some, MPI_Request *first, int count, int &completed) {
+    thread_local std::vector<int> indices;
+    indices.resize(static_cast<size_t>(count));
+    int outcount = 0;
+    const int err = mpi_some(count, first, &outcount, indices.data(), MPI_STATUSES_IGNORE);
+    if (outcount == MPI_UNDEFINED)
+      return err;
+    // Completed persistent requests stay inactive instead of becoming MPI_REQUEST_NULL:
+    // clear their slot so that compact() can move past them
+    for (int i = 0; i < outcount; i++)
+      first[indices[i]] = MPI_REQUEST_NULL;
+    completed += outcount;
+    return err;
+  }
+
+  // Advance tail over the completed prefix of the ring
+  void compact() {
+    while (tail != head && requests[tail & (capacity - 1)] == MPI_REQUEST_NULL)
+      tail++;
+  }
+
+  auto move_tail() -> size_t {
+    const uint64_t old_tail = tail;
+    testsome();
+    return tail - old_tail;
+  }
+
+  // Double the ring. Pending requests keep their ticket and move to
+  // ticket & (new_capacity - 1), so outstanding handles stay valid.
+  void expand() {
+    const size_t new_capacity = capacity << 1;
+    auto new_requests = std::make_unique<MPI_Request[]>(new_capacity);
+    auto new_tickets = std::make_unique<uint64_t[]>(new_capacity);
+    for (size_t i = 0; i < new_capacity; i++) {
+      new_requests[i] = MPI_REQUEST_NULL;
+      new_tickets[i] = no_ticket;
+    }
+    for (uint64_t t = tail; t != head; t++) {
+      new_requests[t & (new_capacity - 1)] = requests[t & (capacity - 1)];
+      new_tickets[t & (new_capacity - 1)] = t;
+    }
+    requests = std::move(new_requests);
+    tickets = std::move(new_tickets);
+    capacity = new_capacity;
+  }
+
+  size_t capacity;
+  std::unique_ptr<MPI_Request[]> requests;
+  std::unique_ptr<uint64_t[]> tickets;
+  uint64_t head;
+  uint64_t tail;
+};
+
+} // namespace empi::details
+
+#endif /* INCLUDE_EMPI_REQUEST_RING */
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_SHARED_BUFFER_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_SHARED_BUFFER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mpi.h>
+#include <new>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <empi/async_event.hpp>
+#include <empi/datatype.hpp>
+#include <empi/request_pool.hpp>
+
+namespace empi {
+
+// Per process segment of n elements in a node shared window (MPI_Win_allocate_shared),
+// created by MessageGroup::shared_buffer. Each exchange is symmetric, every peer
+// passed to post() reads this process' segment and is read by it:
+//
+//     write local(); post(peers); read get(peer) for each peer; release();
+//
+// Peers on the same node are read in place, a ready/done flag pair in front of
+// each segment replaces the messages. Peers on other nodes fall back to
+// Isend/Irecv into a private staging buffer, so get() works the same for both.
+// local() must not be written between post() and the matching release().
+template<typename T>
+class shared_buffer {
+    static_assert(std::is_trivially_copyable_v<T>, "shared_buffer elements are read through shared memory");
+
+    // Written by the owner (ready) and by its readers (done), one cache line
+    // so the flags do not share it with the data
+    struct alignas(64) flags {
+        std::uint64_t ready; // Last epoch posted by the owner
+        std::uint64_t done;  // Acknowledgements from on node readers, over all epochs
+    };
+    static_assert(alignof(T) <= alignof(flags));
+
+  public:
+    shared_buffer(MPI_Comm parent, size_t n, std::shared_ptr<request_pool> pool)
+        : n(n), _request_pool(std::move(pool)) {
+        // Own communicator, the fallback messages never match the group traffic
+        MPI_Comm_dup(parent, &comm);
+        int rank, size;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &size);
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node);
+
+        std::vector<int> ranks(size);
+        std::iota(ranks.begin(), ranks.end(), 0);
+        node_rank_of.resize(size);
+        MPI_Group group, node_group;
+        MPI_Comm_group(comm, &group);
+        MPI_Comm_group(node, &node_group);
+        MPI_Group_translate_ranks(group, size, ranks.data(), node_group, node_rank_of.data());
+        MPI_Group_free(&group);
+        MPI_Group_free(&node_group);
+
+        // Non contiguous: segments of different processes never share a page.
+        // The base is not guaranteed to be cache line aligned, the extra line
+        // leaves room to align the flags (same offset in every process, the
+        // mappings are page aligned).
+        MPI_Info info;
+        MPI_Info_create(&info);
+        MPI_Info_set(info, "alloc_shared_noncontig", "true");
+        void *mine;
+        MPI_Win_allocate_shared(
+            static_cast<MPI_Aint>(2 * sizeof(flags) + n * sizeof(T)), 1, info, node, &mine, &win);
+        MPI_Info_free(&info);
+        own = new(align(mine)) flags{0, 0};
+
+        int node_size;
+        MPI_Comm_size(node, &node_size);
+        segments.resize(node_size);
+        for(int r = 0; r < node_size; r++) {
+            MPI_Aint bytes;
+            int disp;
+            void *base;
+            MPI_Win_shared_query(win, r, &bytes, &disp, &base);
+            segments[r] = align(base);
+        }
+        MPI_Barrier(node);
+    }
+
+    shared_buffer(const shared_buffer &) = delete;
+    shared_buffer &operator=(const shared_buffer &) = delete;
+
+    shared_buffer(shared_buffer &&other) noexcept
+        : n(other.n), _request_pool(std::move(other._request_pool)), comm(std::exchange(other.comm, MPI_COMM_NULL)),
+          node(std::exchange(other.node, MPI_COMM_NULL)), win(std::exchange(other.win, MPI_WIN_NULL)),
+          own(other.own), segments(std::move(other.segments)), node_rank_of(std::move(other.node_rank_of)),
+          peers(std::move(other.peers)), staging(std::move(other.staging)), recvs(std::move(other.recvs)),
+          sends(std::move(other.sends)), epoch(other.epoch), expected_done(other.expected_done) {}
+
+    ~shared_buffer() {
+        if(win == MPI_WIN_NULL) return;
+        for(auto &event : recvs) event.template wait<details::no_status>();
+        for(auto &event : sends) event.template wait<details::no_status>();
+        MPI_Win_free(&win);
+        MPI_Comm_free(&node);
+        MPI_Comm_free(&comm);
+    }
+
+    [[nodiscard]] size_t size() const { return n; }
+
+    // This process' segment, what the peers read
+    [[nodiscard]] std::span<T> local() { return {data_of(own), n}; }
+
+    [[nodiscard]] bool on_node(int peer) const { return node_rank_of[peer] != MPI_UNDEFINED; }
+
+    // Publish local() to peers and start the off node transfers. MPI_PROC_NULL
+    // entries are ignored, duplicates are exchanged once.
+    void post(const std::vector<int> &to) {
+        epoch++;
+        peers.clear();
+        std::copy_if(to.begin(), to.end(), std::back_inserter(peers), [](int p) { return p != MPI_PROC_NULL; });
+        std::sort(peers.begin(), peers.end());
+        peers.erase(std::unique(peers.begin(), peers.end()), peers.end());
+
+        staging.resize(peers.size());
+        recvs.assign(peers.size(), async_event{});
+        sends.clear();
+        const auto type = details::mpi_type<T>::get_type();
+        for(size_t i = 0; i < peers.size(); i++) {
+            if(on_node(peers[i])) {
+                expected_done++;
+                continue;
+            }
+            staging[i].resize(n);
+            recvs[i] = _request_pool->get_req();
+            recvs[i].res = MPI_Irecv(staging[i].data(), static_cast<int>(n), type, peers[i], 0, comm,
+                recvs[i].get_request());
+            auto send = _request_pool->get_req();
+            send.res = MPI_Isend(data_of(own), static_cast<int>(n), type, peers[i], 0, comm, send.get_request());
+            sends.push_back(send);
+        }
+        std::atomic_ref<std::uint64_t>(own->ready).store(epoch, std::memory_order_release);
+    }
+
+    // Segment of peer for the current epoch, waiting for it to be posted.
+    // Valid until release().
+    [[nodiscard]] const T *get(int peer) {
+        const auto it = std::lower_bound(peers.begin(), peers.end(), peer);
+        if(it == peers.end() || *it != peer) throw std::invalid_argument("shared_buffer::get: peer was not posted");
+        const auto i = static_cast<size_t>(it - peers.begin());
+        if(!on_node(peer)) {
+            recvs[i].template wait<details::no_status>();
+            return staging[i].data();
+        }
+        flags *segment = segments[node_rank_of[peer]];
+        spin_until([&] {
+            return std::atomic_ref<std::uint64_t>(segment->ready).load(std::memory_order_acquire) >= epoch;
+        });
+        return data_of(segment);
+    }
+
+    // Done reading the peers: acknowledge them, then wait until every peer
+    // finished reading local(), which can then be overwritten
+    void release() {
+        for(const int peer : peers)
+            if(on_node(peer))
+                std::atomic_ref<std::uint64_t>(segments[node_rank_of[peer]]->done)
+                    .fetch_add(1, std::memory_order_acq_rel);
+        for(auto &event : recvs) event.template wait<details::no_status>();
+        for(auto &event : sends) event.template wait<details::no_status>();
+        sends.clear();
+        spin_until([&] {
+            return std::atomic_ref<std::uint64_t>(own->done).load(std::memory_order_acquire) >= expected_done;
+        });
+    }
+
+  private:
+    static constexpr int spin_limit = 64;
+
+    static flags *align(void *base) {
+        const auto address = reinterpret_cast<std::uintptr_t>(base);
+        return reinterpret_cast<flags *>((address + alignof(flags) - 1) & ~(alignof(flags) - 1));
+    }
+
+    static T *data_of(flags *segment) { return reinterpret_cast<T *>(segment + 1); }
+
+    // Busy wait, yielding once the peer is late so an oversubscribed node still progresses
+    template<typename F>
+    static void spin_until(F &&ready) {
+        for(int spins = 0; !ready(); spins++)
+            if(spins >= spin_limit) std::this_thread::yield();
+    }
+
+    size_t n;
+    std::shared_ptr<request_pool> _request_pool;
+    MPI_Comm comm = MPI_COMM_NULL;
+    MPI_Comm node = MPI_COMM_NULL;
+    MPI_Win win = MPI_WIN_NULL;
+    flags *own = nullptr;
+    std::vector<flags *> segments;  // By node rank
+    std::vector<int> node_rank_of;  // By rank of the group, MPI_UNDEFINED off node
+    std::vector<int> peers;         // Sorted, of the current epoch
+    std::vector<std::vector<T>> staging;
+    std::vector<async_event> recvs; // Parallel to peers, empty for on node ones
+    std::vector<async_event> sends;
+    std::uint64_t epoch = 0;
+    std::uint64_t expected_done = 0;
+};
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_SHARED_BUFFER_HPP_
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_TRACE_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_TRACE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mpi.h>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <empi/defines.hpp>
+
+namespace empi {
+
+// Tracing policies of MessageGroupHandler and BasicMessageGroup. Every traced
+// call constructs a Trace::scope with (function, peer, tag, bytes) when it
+// starts and destroys it when it returns; peer and tag are -1 for collectives
+// and waits. Waits on the group requests (waitall, waitsome) are traced as
+// mpi_function::wait, so their duration is the time spent waiting.
+// Every group with the policy calls Trace::attach(comm) when it is created.
+// Trace::region is a named span the application opens around the calls of
+// one of its phases; the label must have static storage duration.
+
+// Default policy: scope is empty and constexpr, a handler compiles to the same code as without tracing
+struct no_trace {
+    struct scope {
+        constexpr scope(details::mpi_function, int, int, size_t) noexcept {}
+    };
+
+    struct region {
+        constexpr explicit region(const char *) noexcept {}
+    };
+
+    static constexpr void attach(MPI_Comm) noexcept {}
+};
+
+// Opens the trace scope of a call of a handler or group whose policy is Trace.
+// scripts/check_noop_trace.sh defines EMPI_NO_TRACE_SCOPES to build the same
+// tree without any scope and checks that no_trace makes no difference.
+#if defined(EMPI_NO_TRACE_SCOPES)
+#define EMPI_TRACE_SCOPE(...)
+#else
+#define EMPI_TRACE_SCOPE(...) typename Trace::scope trace(__VA_ARGS__)
+#endif
+
+struct trace_event {
+    double start; // MPI_Wtime
+    double end;
+    std::uint64_t bytes;
+    int peer;
+    int tag;
+    details::mpi_function function;
+    const char *label; // Regions only, nullptr for calls
+};
+
+namespace details {
+
+inline const char *function_name(mpi_function f) {
+    switch(f) {
+    case send: return "send";
+    case isend: return "isend";
+    case recv: return "recv";
+    case irecv: return "irecv";
+    case bcast: return "bcast";
+    case ibcast: return "ibcast";
+    case allreduce: return "allreduce";
+    case gatherv: return "gatherv";
+    case reduce: return "reduce";
+    case scatter: return "scatter";
+    case scatterv: return "scatterv";
+    case gather: return "gather";
+    case allgather: return "allgather";
+    case allgatherv: return "allgatherv";
+    case alltoall: return "alltoall";
+    case alltoallv: return "alltoallv";
+    case reduce_scatter: return "reduce_scatter";
+    case scan: return "scan";
+    case exscan: return "exscan";
+    case neighbor_alltoallv: return "neighbor_alltoallv";
+    case barrier: return "barrier";
+    case ibarrier: return "ibarrier";
+    case iallreduce: return "iallreduce";
+    case ireduce: return "ireduce";
+    case igatherv: return "igatherv";
+    case iallgather: return "iallgather";
+    case ialltoall: return "ialltoall";
+    case ineighbor_alltoallv: return "ineighbor_alltoallv";
+    case wait: return "wait";
+    default: return "unknown";
+    }
+}
+
+// Events of one thread, single producer. When full the oldest events are
+// overwritten; the writer never blocks nor allocates.
+class trace_ring {
+  public:
+    static constexpr size_t capacity = size_t{1} << 16;
+
+    explicit trace_ring(int thread) : thread(thread) {}
+
+    void push(const trace_event &event) {
+        const auto h = head.load(std::memory_order_relaxed);
+        events[h & (capacity - 1)] = event;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // Events still in the ring, oldest first. Only consistent once the writer stopped.
+    [[nodiscard]] std::vector<trace_event> snapshot() const {
+        const auto h = head.load(std::memory_order_acquire);
+        std::vector<trace_event> out;
+        for(auto i = h > capacity ? h - capacity : 0; i < h; i++) out.push_back(events[i & (capacity - 1)]);
+        return out;
+    }
+
+    [[nodiscard]] std::uint64_t dropped() const {
+        const auto h = head.load(std::memory_order_acquire);
+        return h > capacity ? h - capacity : 0;
+    }
+
+    const int thread;
+
+  private:
+    std::unique_ptr<trace_event[]> events = std::make_unique<trace_event[]>(capacity);
+    std::atomic<std::uint64_t> head{0};
+};
+
+inline const char *name_of(const trace_event &e) { return e.label ? e.label : function_name(e.function); }
+
+inline const char *category_of(const trace_event &e) {
+    if(e.label) return "region";
+    switch(e.function) {
+    case send:
+    case isend:
+    case recv:
+    case irecv: return "p2p";
+    case wait: return "wait";
+    default: return "collective";
+    }
+}
+
+inline void write_json_string(std::ostream &out, const char *s) {
+    out << '"';
+    for(; *s; s++) {
+        if(*s == '"' || *s == '\\')
+            out << '\\' << *s;
+        else if(static_cast<unsigned char>(*s) >= 0x20)
+            out << *s;
+    }
+    out << '"';
+}
+
+// Events of this rank in the Chrome trace event format (chrome://tracing,
+// ui.perfetto.dev): one process per rank, one thread per recording thread and
+// a slice per call or region, regions enclosing their calls. A flow arrow links each send to its receive, matched by
+// (source, destination, tag) in order like MPI does within a communicator;
+// receives from any source or with any tag are not linked. offset is
+// subtracted from the timestamps.
+inline std::string chrome_events(int rank, std::vector<std::pair<int, trace_event>> events, double offset) {
+    std::stable_sort(events.begin(), events.end(),
+        [](const auto &a, const auto &b) { // Enclosing spans first
+            return a.second.start < b.second.start || (a.second.start == b.second.start && a.second.end > b.second.end);
+        });
+    std::map<std::pair<int, int>, std::uint64_t> sent, received; // By (peer, tag)
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    out << R"({"name":"process_name","ph":"M","pid":)" << rank << R"(,"args":{"name":"rank )" << rank << R"("}},)"
+        << '\n'
+        << R"({"name":"process_sort_index","ph":"M","pid":)" << rank << R"(,"args":{"sort_index":)" << rank << "}}";
+    for(const auto &[thread, e] : events) {
+        const double ts = (e.start - offset) * 1e6;
+        out << ",\n" << R"({"name":)";
+        write_json_string(out, name_of(e));
+        out << R"(,"cat":")" << category_of(e) << R"(","ph":"X","pid":)" << rank << R"(,"tid":)" << thread
+            << R"(,"ts":)" << ts << R"(,"dur":)" << (e.end - e.start) * 1e6 << R"(,"args":{"peer":)" << e.peer
+            << R"(,"tag":)" << e.tag << R"(,"bytes":)" << e.bytes << "}}";
+        if(e.peer < 0 || e.tag < 0) continue;
+        const bool sending = e.function == send || e.function == isend;
+        if(!sending && e.function != recv && e.function != irecv) continue;
+        const auto seq = (sending ? sent : received)[{e.peer, e.tag}]++;
+        const int source = sending ? rank : e.peer;
+        const int dest = sending ? e.peer : rank;
+        out << ",\n"
+            << R"({"name":"message","cat":"p2p","ph":")" << (sending ? "s" : R"(f","bp":"e)") << R"(","id":")"
+            << source << '>' << dest << ':' << e.tag << ':' << seq << R"(","pid":)" << rank << R"(,"tid":)" << thread
+            << R"(,"ts":)" << ts << '}';
+    }
+    return out.str();
+}
+
+// Collective over comm: each rank formats its own events, then they are written
+// side by side into one JSON file with MPI-IO. Timestamps are aligned to the
+// clock of rank 0, sampled right after a barrier.
+inline void write_chrome_trace(MPI_Comm comm, const std::string &file, std::vector<std::pair<int, trace_event>> events) {
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    MPI_Barrier(comm);
+    const double now = MPI_Wtime();
+    double origin = now;
+    MPI_Bcast(&origin, 1, MPI_DOUBLE, 0, comm);
+
+    std::string body = rank == 0 ? "{\"traceEvents\":[\n" : ",\n";
+    body += chrome_events(rank, std::move(events), now - origin);
+    if(rank == size - 1) body += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    long long length = static_cast<long long>(body.size()), offset = 0;
+    MPI_Exscan(&length, &offset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+    if(rank == 0) offset = 0;
+    MPI_File fh;
+    MPI_File_open(comm, file.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+    MPI_File_set_size(fh, 0);
+    MPI_File_write_at_all(fh, offset, body.data(), static_cast<int>(body.size()), MPI_CHAR, MPI_STATUS_IGNORE);
+    MPI_File_close(&fh);
+}
+
+// Rings of every thread that recorded an event. The first traced group sets an
+// attribute on MPI_COMM_SELF whose delete callback dumps the traces: MPI_Finalize
+// runs it first thing, i.e. at Context destruction, while MPI is still usable.
+// The Chrome trace is merged over (a copy of) the communicator of that group,
+// so the first traced group of every process should be over the same
+// communicator, usually MPI_COMM_WORLD; its ranks are the peers of the events.
+class trace_registry {
+  public:
+    // Never destroyed: MPI_Finalize may run from the destructor of a static
+    // Context, after function-local statics created later are gone
+    static trace_registry &instance() {
+        static auto *registry = new trace_registry;
+        return *registry;
+    }
+
+    // Ring of the calling thread, created on its first event
+    trace_ring &local() {
+        thread_local std::shared_ptr<trace_ring> ring = add();
+        return *ring;
+    }
+
+    // Collective over comm the first time
+    void attach(MPI_Comm comm) {
+        std::lock_guard lock(mutex);
+        if(merge != MPI_COMM_NULL) return;
+        MPI_Comm_dup(comm, &merge);
+        int key;
+        MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, at_finalize, &key, nullptr);
+        MPI_Comm_set_attr(MPI_COMM_SELF, key, nullptr);
+    }
+
+    // With the prefix from EMPI_TRACE_PREFIX (default empi_trace), the events of
+    // every rank go to <prefix>.json as a Chrome trace (write_chrome_trace) and
+    // the ones of this rank to <prefix>.<rank>.txt, one event per line (the
+    // label in place of the function for regions):
+    //
+    //     # thread function peer tag bytes start duration
+    //     0 isend 1 0 8192 0.000153 1.2e-06
+    void dump() {
+        int rank;
+        MPI_Comm_rank(merge, &rank);
+        const char *env = std::getenv("EMPI_TRACE_PREFIX");
+        const std::string prefix = env ? env : "empi_trace";
+        std::vector<std::pair<int, trace_event>> events;
+        {
+            std::ofstream out(prefix + "." + std::to_string(rank) + ".txt");
+            out.precision(12);
+            out << "# thread function peer tag bytes start duration\n";
+            std::lock_guard lock(mutex);
+            for(const auto &ring : rings) {
+                if(const auto lost = ring->dropped()) out << "# thread " << ring->thread << " dropped " << lost << '\n';
+                for(const auto &e : ring->snapshot()) {
+                    out << ring->thread << ' ' << name_of(e) << ' ' << e.peer << ' ' << e.tag << ' '
+                        << e.bytes << ' ' << e.start << ' ' << e.end - e.start << '\n';
+                    events.emplace_back(ring->thread, e);
+                }
+            }
+        }
+        write_chrome_trace(merge, prefix + ".json", std::move(events));
+        MPI_Comm_free(&merge);
+    }
+
+  private:
+    std::shared_ptr<trace_ring> add() {
+        std::lock_guard lock(mutex);
+        rings.push_back(std::make_shared<trace_ring>(static_cast<int>(rings.size())));
+        return rings.back();
+    }
+
+    static int at_finalize(MPI_Comm, int key, void *, void *) {
+        instance().dump();
+        MPI_Comm_free_keyval(&key);
+        return MPI_SUCCESS;
+    }
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<trace_ring>> rings;
+    MPI_Comm merge = MPI_COMM_NULL;
+};
+
+} // namespace details
+
+// Records every traced call into a per-thread ring, see details::trace_registry
+// for the dump. Two MPI_Wtime calls and a ring write per call.
+struct recording_trace {
+    class scope {
+      public:
+        scope(details::mpi_function function, int peer, int tag, size_t bytes)
+            : event{MPI_Wtime(), 0.0, bytes, peer, tag, function, nullptr} {}
+
+        scope(const scope &) = delete;
+        scope &operator=(const scope &) = delete;
+
+        ~scope() {
+            event.end = MPI_Wtime();
+            details::trace_registry::instance().local().push(event);
+        }
+
+      protected:
+        explicit scope(const char *label) : event{MPI_Wtime(), 0.0, 0, -1, -1, details::mpi_function::all, label} {}
+
+      private:
+        trace_event event;
+    };
+
+    struct region : scope {
+        explicit region(const char *label) : scope(label) {}
+    };
+
+    static void attach(MPI_Comm comm) { details::trace_registry::instance().attach(comm); }
+};
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_TRACE_HPP_
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_TUNING_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_TUNING_HPP_
+
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <empi/collectives.hpp>
+#include <empi/defines.hpp>
+
+namespace empi {
+
+// Autotuning of Bcast/Allreduce, see Context
+struct tuning_options {
+    std::string file;    // Tuning table loaded at startup, EMPI_TUNING_FILE when empty
+    bool online = false; // Sizes missing from the table are tuned in their first calls
+    int trials = 3;      // Calls per candidate algorithm when tuning online
+};
+
+// A tuned call: the collective, the group shape and the message size bucket,
+// floor(log2(bytes)) (0 for empty messages)
+struct tuning_key {
+    details::mpi_function function;
+    int comm_size;
+    int ranks_per_node;
+    int log2_bytes;
+
+    auto operator<=>(const tuning_key &) const = default;
+
+    [[nodiscard]] static int bucket(size_t bytes) { return static_cast<int>(std::bit_width(bytes | 1)) - 1; }
+};
+
+// Fastest algorithm per tuning_key. The file format is one entry per line,
+// written by scripts/autotune.py or save():
+//
+//     # function comm_size ranks_per_node log2_bytes mode segment
+//     allreduce 16 8 20 ring 65536
+//
+// Blank lines and lines starting with # are ignored.
+class tuning_table {
+  public:
+    [[nodiscard]] std::optional<threshold> find(const tuning_key &key) const {
+        const auto it = entries.find(key);
+        if(it == entries.end()) return std::nullopt;
+        return it->second;
+    }
+
+    void insert(const tuning_key &key, threshold algorithm) { entries[key] = algorithm; }
+
+    void merge(const tuning_table &other) {
+        for(const auto &[key, algorithm] : other.entries) entries[key] = algorithm;
+    }
+
+    [[nodiscard]] size_t size() const { return entries.size(); }
+
+    // A missing file is an empty table, a malformed one throws std::runtime_error
+    [[nodiscard]] static tuning_table load(const std::string &path) {
+        tuning_table table;
+        std::ifstream in(path);
+        std::string line;
+        for(int number = 1; std::getline(in, line); number++) {
+            std::istringstream fields(line);
+            std::string function, mode;
+            tuning_key key{};
+            threshold algorithm{0, collective_mode::flat};
+            if(!(fields >> function) || function.front() == '#') continue;
+            fields >> key.comm_size >> key.ranks_per_node >> key.log2_bytes >> mode >> algorithm.segment;
+            const auto f = function_of(function);
+            const auto m = mode_of(mode);
+            if(!fields || !f || !m)
+                throw std::runtime_error("tuning table " + path + ":" + std::to_string(number) + ": malformed entry");
+            key.function = *f;
+            algorithm.mode = *m;
+            table.entries[key] = algorithm;
+        }
+        return table;
+    }
+
+    void save(const std::string &path) const {
+        std::ofstream out(path);
+        out << "# function comm_size ranks_per_node log2_bytes mode segment\n";
+        for(const auto &[key, algorithm] : entries)
+            out << (key.function == details::mpi_function::allreduce ? "allreduce" : "bcast") << ' ' << key.comm_size
+                << ' ' << key.ranks_per_node << ' ' << key.log2_bytes << ' ' << name_of(algorithm.mode) << ' '
+                << algorithm.segment << '\n';
+        if(!out) throw std::runtime_error("tuning table " + path + ": write failed");
+    }
+
+  private:
+    static constexpr std::pair<const char *, collective_mode> modes[] = {{"flat", collective_mode::flat},
+        {"hierarchical", collective_mode::hierarchical}, {"chain", collective_mode::chain},
+        {"binary_tree", collective_mode::binary_tree}, {"ring", collective_mode::ring}};
+
+    static std::optional<collective_mode> mode_of(const std::string &name) {
+        for(const auto &[n, mode] : modes)
+            if(name == n) return mode;
+        return std::nullopt;
+    }
+
+    static const char *name_of(collective_mode mode) {
+        for(const auto &[n, m] : modes)
+            if(m == mode) return n;
+        return "flat";
+    }
+
+    static std::optional<details::mpi_function> function_of(const std::string &name) {
+        if(name == "allreduce") return details::mpi_function::allreduce;
+        if(name == "bcast") return details::mpi_function::bcast;
+        return std::nullopt;
+    }
+
+    std::map<tuning_key, threshold> entries; // max_bytes is unused, the key holds the size
+};
+
+namespace details {
+
+// Tuning state of a Context, shared by its groups
+struct tuning {
+    explicit tuning(tuning_options options) : options(std::move(options)), table(tuning_table::load(this->options.file)) {}
+
+    void learn(const tuning_key &key, threshold algorithm) {
+        std::lock_guard<std::mutex> lock(mutex);
+        learned.insert(key, algorithm);
+    }
+
+    [[nodiscard]] tuning_table results() {
+        std::lock_guard<std::mutex> lock(mutex);
+        tuning_table all = table;
+        all.merge(learned);
+        return all;
+    }
+
+    const tuning_options options;
+    const tuning_table table; // Read only once loaded, no locking needed
+
+  private:
+    std::mutex mutex;
+    tuning_table learned; // Online winners of every group
+};
+
+} // namespace details
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_TUNING_HPP_
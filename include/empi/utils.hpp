@@ -7,6 +7,8 @@
 
 #include <empi/type_traits.hpp>
 #include <empi/defines.hpp>
+#include <limits>
+#include <stdexcept>
 
 namespace empi::details{
 
@@ -31,6 +33,17 @@ namespace empi::details{
 			return std::abs(static_cast<long long>(a) - static_cast<long long>(b));
 		}
 
+		// MPI_TAG_UB is inherited by every communicator, so it is queried only once
+		inline int tag_ub(){
+			static const int ub = [] {
+				int *value;
+				int flag;
+				MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &value, &flag);
+				return flag ? *value : std::numeric_limits<int>::max();
+			}();
+			return ub;
+		}
+
 		template<mpi_function f> 
 		void checktag(int tag, int maxtag){
 			if constexpr (details::is_all<f>){
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_VIEW_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_VIEW_HPP_
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <mpi.h>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include <empi/datatype.hpp>
+
+#if defined(__has_include)
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
+#endif
+#include <ranges>
+
+namespace empi {
+
+// Non-owning N-dimensional strided view over elements of type T.
+// extents[i] elements are taken along dimension i, strides[i] elements apart;
+// the last dimension is the fastest varying one.
+// A view is sent as a single element of a derived datatype, so the data never
+// goes through a user-side staging buffer.
+template<typename T, std::size_t N>
+struct strided_view {
+    using element_type = T;
+    static constexpr std::size_t rank = N;
+
+    T *base;
+    std::array<int, N> extents;
+    std::array<int, N> strides;
+
+    [[nodiscard]] std::size_t size() const {
+        std::size_t n = 1;
+        for(auto e : extents) n *= static_cast<std::size_t>(e);
+        return n;
+    }
+};
+
+// count elements, stride elements apart
+template<typename T>
+constexpr strided_view<T, 1> strided(T *base, int count, int stride) {
+    return {base, {count}, {stride}};
+}
+
+// count blocks of blocklength contiguous elements, stride elements apart
+template<typename T>
+constexpr strided_view<T, 2> strided(T *base, int count, int blocklength, int stride) {
+    return {base, {count, blocklength}, {stride, 1}};
+}
+
+// Row-major subarray of subsizes elements starting at starts, within an array of sizes elements
+template<typename T, std::size_t N>
+constexpr strided_view<T, N> subarray(T *base, const std::array<int, N> &sizes, const std::array<int, N> &subsizes,
+    const std::array<int, N> &starts) {
+    strided_view<T, N> v{base, subsizes, {}};
+    std::ptrdiff_t stride = 1;
+    std::ptrdiff_t offset = 0;
+    for(std::size_t i = N; i-- > 0;) {
+        v.strides[i] = static_cast<int>(stride);
+        offset += starts[i] * stride;
+        stride *= sizes[i];
+    }
+    v.base += offset;
+    return v;
+}
+
+template<typename T, std::size_t N>
+constexpr strided_view<T, N> view(const strided_view<T, N> &v) {
+    return v;
+}
+
+#if defined(__cpp_lib_mdspan)
+// Any strided mdspan layout (layout_right, layout_left, layout_stride)
+template<typename T, typename Extents, typename Layout, typename Accessor>
+strided_view<T, Extents::rank()> view(const std::mdspan<T, Extents, Layout, Accessor> &m) {
+    strided_view<T, Extents::rank()> v{m.data_handle(), {}, {}};
+    for(std::size_t i = 0; i < Extents::rank(); i++) {
+        v.extents[i] = static_cast<int>(m.extent(i));
+        v.strides[i] = static_cast<int>(m.stride(i));
+    }
+    return v;
+}
+#endif
+
+#if defined(__cpp_lib_ranges_stride)
+// std::views::stride over a contiguous range
+template<std::ranges::contiguous_range V>
+auto view(const std::ranges::stride_view<V> &s) {
+    using T = std::remove_reference_t<std::ranges::range_reference_t<V>>;
+    return strided_view<T, 1>{std::ranges::data(s.base()), {static_cast<int>(std::ranges::size(s))},
+        {static_cast<int>(s.stride())}};
+}
+#endif
+
+template<typename V>
+using view_t = decltype(view(std::declval<const std::remove_cvref_t<V> &>()));
+
+namespace details {
+
+// Committed datatype describing a whole view. Dimensions that are contiguous with
+// the next one are merged, so a view that is contiguous in memory maps to a plain
+// contiguous type.
+template<typename T, std::size_t N>
+MPI_Datatype make_view_type(const std::array<int, N> &extents, const std::array<int, N> &strides) {
+    std::array<int, N> e{};
+    std::array<int, N> s{};
+    std::size_t dims = 0;
+    for(std::size_t i = 0; i < N; i++) {
+        if(extents[i] == 1) continue;
+        if(dims > 0 && s[dims - 1] == extents[i] * strides[i]) {
+            e[dims - 1] *= extents[i];
+            s[dims - 1] = strides[i];
+        } else {
+            e[dims] = extents[i];
+            s[dims] = strides[i];
+            dims++;
+        }
+    }
+    if(dims == 0) {
+        e[0] = 1;
+        s[0] = 1;
+        dims = 1;
+    }
+
+    MPI_Datatype type;
+    const MPI_Datatype element = mpi_type<T>::get_type();
+    if(s[dims - 1] == 1)
+        MPI_Type_contiguous(e[dims - 1], element, &type);
+    else
+        MPI_Type_vector(e[dims - 1], 1, s[dims - 1], element, &type);
+    for(std::size_t i = dims - 1; i-- > 0;) {
+        MPI_Datatype outer;
+        MPI_Type_create_hvector(e[i], 1, static_cast<MPI_Aint>(s[i]) * static_cast<MPI_Aint>(sizeof(T)), type, &outer);
+        MPI_Type_free(&type);
+        type = outer;
+    }
+    MPI_Type_commit(&type);
+    return type;
+}
+
+// Datatype of a view, built once per shape and cached for the process lifetime.
+// Posting threads look it up in their own cache without locking; only a shape
+// new to the thread goes through the shared cache, which builds it at most once.
+template<typename T, std::size_t N>
+MPI_Datatype view_type(const std::array<int, N> &extents, const std::array<int, N> &strides) {
+    using key = std::pair<std::array<int, N>, std::array<int, N>>;
+    thread_local std::map<key, MPI_Datatype> local;
+    auto it = local.find({extents, strides});
+    if(it != local.end()) [[likely]]
+        return it->second;
+
+    static std::mutex mutex;
+    static std::map<key, MPI_Datatype> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto shared = cache.find({extents, strides});
+    if(shared == cache.end()) shared = cache.emplace(key{extents, strides}, make_view_type<T>(extents, strides)).first;
+    local.emplace(shared->first, shared->second);
+    return shared->second;
+}
+
+} // namespace details
+
+template<typename V>
+concept viewable = requires(const std::remove_cvref_t<V> &v) { view(v); };
+
+template<typename V, typename T>
+concept is_valid_view = viewable<V> && std::is_same_v<std::remove_const_t<typename view_t<V>::element_type>, T>;
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_VIEW_HPP_
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+ */
+
+#ifndef EMPI_PROJECT_INCLUDE_EMPI_WINDOW_HPP_
+#define EMPI_PROJECT_INCLUDE_EMPI_WINDOW_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <mpi.h>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <empi/async_event.hpp>
+#include <empi/datatype.hpp>
+#include <empi/request_pool.hpp>
+
+namespace empi {
+
+// RMA synchronization epoch, closed on destruction (or by close()).
+// Obtained from Window::fence, lock, lock_all, access and exposure.
+class rma_epoch {
+  public:
+    enum class kind { fence, lock, lock_all, access, exposure };
+
+    rma_epoch(MPI_Win win, kind k, int target = MPI_PROC_NULL) : win(win), k(k), target(target) {}
+
+    rma_epoch(const rma_epoch &) = delete;
+    rma_epoch &operator=(const rma_epoch &) = delete;
+
+    rma_epoch(rma_epoch &&other) noexcept
+        : win(std::exchange(other.win, MPI_WIN_NULL)), k(other.k), target(other.target) {}
+
+    ~rma_epoch() { close(); }
+
+    // fence: completes every operation of the epoch on all the processes
+    // lock/lock_all: completes the operations at origin and target
+    // access: completes the operations at origin, exposure: waits for every origin
+    int close() {
+        if(win == MPI_WIN_NULL) return MPI_SUCCESS;
+        const MPI_Win w = std::exchange(win, MPI_WIN_NULL);
+        switch(k) {
+        case kind::fence: return MPI_Win_fence(MPI_MODE_NOSUCCEED, w);
+        case kind::lock: return MPI_Win_unlock(target, w);
+        case kind::lock_all: return MPI_Win_unlock_all(w);
+        case kind::access: return MPI_Win_complete(w);
+        case kind::exposure: return MPI_Win_wait(w);
+        }
+        return MPI_SUCCESS;
+    }
+
+    // Fence epochs only: closes this epoch and opens the next one with a single
+    // MPI_Win_fence, so n consecutive epochs cost n + 1 fences instead of 2n
+    int fence(int assert = 0) {
+        if(win == MPI_WIN_NULL || k != kind::fence) return MPI_ERR_RMA_SYNC;
+        return MPI_Win_fence(assert, win);
+    }
+
+  private:
+    MPI_Win win;
+    kind k;
+    int target;
+};
+
+// Typed RMA window over a MessageGroup communicator, see MessageGroup::create_window.
+// The displacement unit is sizeof(T): every disp is an element index in the
+// target's window. Operations are only valid inside an epoch:
+//
+//     { auto epoch = win.lock(target); win.put(data, n, target, 0); } // unlocked here
+//
+// The request based Rput/Rget/Raccumulate go through the group's request pool
+// and, as in MPI, are only allowed in passive target (lock/lock_all) epochs.
+template<typename T>
+class Window {
+  public:
+    // Allocates n elements per process (MPI_Win_allocate)
+    Window(MPI_Comm comm, size_t n, std::shared_ptr<request_pool> pool) : n(n), _request_pool(std::move(pool)) {
+        MPI_Win_allocate(static_cast<MPI_Aint>(n * sizeof(T)), sizeof(T), MPI_INFO_NULL, comm, &base, &win);
+        MPI_Win_get_group(win, &group);
+    }
+
+    // Exposes n elements at base owned by the caller (MPI_Win_create)
+    Window(MPI_Comm comm, T *base, size_t n, std::shared_ptr<request_pool> pool)
+        : n(n), base(base), _request_pool(std::move(pool)) {
+        MPI_Win_create(base, static_cast<MPI_Aint>(n * sizeof(T)), sizeof(T), MPI_INFO_NULL, comm, &win);
+        MPI_Win_get_group(win, &group);
+    }
+
+    Window(const Window &) = delete;
+    Window &operator=(const Window &) = delete;
+
+    Window(Window &&other) noexcept
+        : n(other.n), base(other.base), _request_pool(std::move(other._request_pool)),
+          win(std::exchange(other.win, MPI_WIN_NULL)), group(std::exchange(other.group, MPI_GROUP_NULL)) {}
+
+    ~Window() {
+        if(win == MPI_WIN_NULL) return;
+        MPI_Group_free(&group);
+        MPI_Win_free(&win);
+    }
+
+    [[nodiscard]] size_t size() const { return n; }
+
+    // This process' part of the window
+    [[nodiscard]] std::span<T> local() { return {base, n}; }
+
+    [[nodiscard]] MPI_Win native() const { return win; }
+
+    // ------------------ EPOCHS -----------------------------
+
+    // Active target, collective: every process opens and closes it. Opening and
+    // closing are a fence each; back to back epochs should instead go through
+    // rma_epoch::fence, which pays one fence per epoch.
+    [[nodiscard]] rma_epoch fence(int assert = 0) {
+        MPI_Win_fence(assert | MPI_MODE_NOPRECEDE, win);
+        return {win, rma_epoch::kind::fence};
+    }
+
+    // Passive target on a single process
+    [[nodiscard]] rma_epoch lock(int target, int lock_type = MPI_LOCK_SHARED, int assert = 0) {
+        MPI_Win_lock(lock_type, target, assert, win);
+        return {win, rma_epoch::kind::lock, target};
+    }
+
+    // Passive target, shared lock on every process
+    [[nodiscard]] rma_epoch lock_all(int assert = 0) {
+        MPI_Win_lock_all(assert, win);
+        return {win, rma_epoch::kind::lock_all};
+    }
+
+    // Generalized active target (PSCW): access to targets, matching their exposure to us
+    [[nodiscard]] rma_epoch access(const std::vector<int> &targets, int assert = 0) {
+        MPI_Group peers = subgroup(targets);
+        MPI_Win_start(peers, assert, win);
+        MPI_Group_free(&peers);
+        return {win, rma_epoch::kind::access};
+    }
+
+    // Exposes the local window to origins, closing waits until all of them completed their access
+    [[nodiscard]] rma_epoch exposure(const std::vector<int> &origins, int assert = 0) {
+        MPI_Group peers = subgroup(origins);
+        MPI_Win_post(peers, assert, win);
+        MPI_Group_free(&peers);
+        return {win, rma_epoch::kind::exposure};
+    }
+
+    // Completes the operations to target (all targets) inside a lock epoch
+    int flush(int target) { return MPI_Win_flush(target, win); }
+
+    int flush_all() { return MPI_Win_flush_all(win); }
+
+    // ------------------ END EPOCHS -----------------------------
+    // ------------------ PUT/GET -----------------------------
+
+    int put(const T *origin, int count, int target, MPI_Aint disp) {
+        return MPI_Put(origin, count, type(), target, disp, count, type(), win);
+    }
+
+    int get(T *origin, int count, int target, MPI_Aint disp) {
+        return MPI_Get(origin, count, type(), target, disp, count, type(), win);
+    }
+
+    int accumulate(const T *origin, int count, int target, MPI_Aint disp, MPI_Op op) {
+        return MPI_Accumulate(origin, count, type(), target, disp, count, type(), op, win);
+    }
+
+    // result receives the target elements before op is applied
+    int get_accumulate(const T *origin, T *result, int count, int target, MPI_Aint disp, MPI_Op op) {
+        return MPI_Get_accumulate(origin, count, type(), result, count, type(), target, disp, count, type(), op, win);
+    }
+
+    // Single element atomic update, e.g. a remote counter with MPI_SUM
+    int fetch_and_op(const T &origin, T &result, int target, MPI_Aint disp, MPI_Op op) {
+        return MPI_Fetch_and_op(&origin, &result, type(), target, disp, op, win);
+    }
+
+    int compare_and_swap(const T &origin, const T &compare, T &result, int target, MPI_Aint disp) {
+        return MPI_Compare_and_swap(&origin, &compare, &result, type(), target, disp, win);
+    }
+
+    // ------------------ END PUT/GET -----------------------------
+    // ------------------ REQUEST BASED -----------------------------
+
+    async_event Rput(const T *origin, int count, int target, MPI_Aint disp) {
+        auto event = _request_pool->get_req();
+        event.res = MPI_Rput(origin, count, type(), target, disp, count, type(), win, event.get_request());
+        return event;
+    }
+
+    async_event Rget(T *origin, int count, int target, MPI_Aint disp) {
+        auto event = _request_pool->get_req();
+        event.res = MPI_Rget(origin, count, type(), target, disp, count, type(), win, event.get_request());
+        return event;
+    }
+
+    async_event Raccumulate(const T *origin, int count, int target, MPI_Aint disp, MPI_Op op) {
+        auto event = _request_pool->get_req();
+        event.res =
+            MPI_Raccumulate(origin, count, type(), target, disp, count, type(), op, win, event.get_request());
+        return event;
+    }
+
+    // ------------------ END REQUEST BASED -----------------------------
+
+  private:
+    static MPI_Datatype type() { return details::mpi_type<T>::get_type(); }
+
+    MPI_Group subgroup(const std::vector<int> &ranks) const {
+        MPI_Group peers;
+        MPI_Group_incl(group, static_cast<int>(ranks.size()), ranks.data(), &peers);
+        return peers;
+    }
+
+    size_t n;
+    T *base = nullptr;
+    std::shared_ptr<request_pool> _request_pool;
+    MPI_Win win = MPI_WIN_NULL;
+    MPI_Group group = MPI_GROUP_NULL;
+};
+
+} // namespace empi
+
+#endif // EMPI_PROJECT_INCLUDE_EMPI_WINDOW_HPP_
@@ -0,0 +1,78 @@
+# Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+
+#!/usr/bin/python3
+# Offline tuning run: times every EMPI Bcast/Allreduce algorithm with the
+# minibench examples and writes the fastest per message size as a tuning table,
+# loaded by empi::Context from EMPI_TUNING_FILE (or tuning_options::file).
+import command
+import common
+from common import make_minibench_command
+
+# Benchmark element sizes, the examples take the number of elements as a power of two
+ALLREDUCE_LOG2_ELEMENT = 2 # int
+BCAST_LOG2_ELEMENT = 0 # char
+SEGMENTS = ["16384", "65536", "262144"]
+
+def measure(args, run_command):
+	time_sum = 0.0
+	for i in range(0,args.app_restart,1):
+		time_sum += float(command.run(run_command).output)
+	return time_sum/args.app_restart
+
+def fastest(args, name, candidates):
+	times = {}
+	for (mode, segment), exp in candidates.items():
+		times[(mode, segment)] = measure(args, make_minibench_command(args, exp[0]) + exp[1:])
+		print(f'{name} -- size: {args.size} -- {mode} ({segment} B segments): {times[(mode, segment)]}')
+	return min(times, key=times.get)
+
+if __name__ == '__main__':
+	p = common.base_args()
+	p = common.common_args(p)
+	p.add_argument("--bench_path",
+                 type=str,
+                 default="../build/examples/",
+                 help="Path to the benchmark folder (default: ../build/examples)"
+                 )
+	p.add_argument("--min_size",
+                 type=int,
+                 default=2,
+                 help="Smallest number of elements in power-of-two, --size is the largest (default: 2)"
+                 )
+	p.add_argument("--ranks_per_node",
+                 type=int,
+                 default=0,
+                 help="Processes per node of the tuned runs (default: num_proc, a single node)"
+                 )
+	p.add_argument("--output",
+                 type=str,
+                 default="empi_tuning.txt",
+                 help="Tuning table file (default: empi_tuning.txt)"
+                 )
+	args = p.parse_args()
+	ranks_per_node = args.ranks_per_node if args.ranks_per_node > 0 else args.num_proc
+	max_size = args.size
+
+	lines = ["# function comm_size ranks_per_node log2_bytes mode segment"]
+	for size in range(args.min_size, max_size + 1):
+		args.size = size
+		candidates = {("flat", "65536"): ["all_reduce/empi_allreduce"]}
+		for segment in SEGMENTS:
+			candidates[("ring", segment)] = ["all_reduce/empi_ring_allreduce", segment]
+		if ranks_per_node > 1:
+			candidates[("hierarchical", "65536")] = ["all_reduce/empi_hierarchical_allreduce"]
+		mode, segment = fastest(args, "Allreduce", candidates)
+		lines.append(f"allreduce {args.num_proc} {ranks_per_node} {size + ALLREDUCE_LOG2_ELEMENT} {mode} {segment}")
+
+		candidates = {("flat", "65536"): ["bcast/empi_bcast"]}
+		for algorithm, mode in [("chain", "chain"), ("tree", "binary_tree")]:
+			for segment in SEGMENTS:
+				candidates[(mode, segment)] = ["bcast/empi_pipelined_bcast", algorithm, segment]
+		if ranks_per_node > 1:
+			candidates[("hierarchical", "65536")] = ["bcast/empi_hierarchical_bcast"]
+		mode, segment = fastest(args, "Bcast", candidates)
+		lines.append(f"bcast {args.num_proc} {ranks_per_node} {size + BCAST_LOG2_ELEMENT} {mode} {segment}")
+
+	with open(args.output, "w") as table:
+		table.write("\n".join(lines) + "\n")
+	print(f"Tuning table written to {args.output}")
@@ -0,0 +1,48 @@
+# Copyright (c) 2022-2023 University of Salerno, Italy. All rights reserved.
+
+#!/bin/bash
+# Checks that the default no_trace policy compiles to nothing: every EMPI example
+# is compiled twice from the current headers, as is and with EMPI_NO_TRACE_SCOPES
+# defined (every trace scope and attach compiled out, see trace.hpp), and the
+# disassembly, function by function with symbol names left out, must be identical.
+#
+# Usage: ./check_noop_trace.sh [sources relative to the repository root...]
+# CXX (default mpicxx) and CXXFLAGS (default -O2) are honored.
+
+REPO=$(git -C "$(dirname "$0")" rev-parse --show-toplevel) || exit 1
+SOURCES=("$@")
+if [ ${#SOURCES[@]} -eq 0 ]; then
+	mapfile -t SOURCES < <(cd "$REPO" && ls examples/*/empi_*.cpp)
+fi
+CXX=${CXX:-mpicxx}
+CXXFLAGS=${CXXFLAGS:--O2}
+
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+# config.hpp is generated by cmake
+cmake -S "$REPO" -B "$WORK/build" > /dev/null 2>&1 || exit 1
+
+# One line per function with its instructions, sorted: symbol and section names
+# are left out and the order in which the compiler emits functions is ignored
+# (objects are built with -ffunction-sections, so addresses are relative to the function)
+function disassemble {
+	objdump -d --no-show-raw-insn "$1" | sed -E '/file format|^Disassembly of section/d; s/<[^>]*>//g' |
+		awk '/^[0-9a-f]+ :$/ { if(block) print block; block=""; next } NF { block = block "|" $0 } END { if(block) print block }' | sort
+}
+
+declare failed=0
+for source in "${SOURCES[@]}"
+do
+	name=$(basename "$source" .cpp)
+	$CXX -std=c++20 $CXXFLAGS -ffunction-sections -DEMPI_NO_TRACE_SCOPES -I"$REPO/include" -I"$WORK/build/include" -c "$REPO/$source" -o "$WORK/$name.untraced.o" || exit 1
+	$CXX -std=c++20 $CXXFLAGS -ffunction-sections -I"$REPO/include" -I"$WORK/build/include" -c "$REPO/$source" -o "$WORK/$name.o" || exit 1
+	if cmp -s <(disassemble "$WORK/$name.untraced.o") <(disassemble "$WORK/$name.o"); then
+		echo "OK   $source"
+	else
+		echo "DIFF $source"
+		failed=$((failed + 1))
+	fi
+done
+
+echo "Differences: $failed"
+[ $failed -eq 0 ]
@@ -20,16 +20,51 @@ if __name__ == '__main__':
 	args.num_proc = 2
 	run_experiment(args, "Ping pong: MPI", make_minibench_command(args, "ping_pong/mpi_ping_pong"),noop)
 	run_experiment(args, "Ping_pong: EMPI", make_minibench_command(args, "ping_pong/empi_ping_pong"),noop)
+	run_experiment(args, "Ping_pong: EMPI (RMA)", make_minibench_command(args, "ping_pong/empi_rma_ping_pong"),noop)
+	run_experiment(args, "Ping_pong: EMPI (RMA, fence)", make_minibench_command(args, "ping_pong/empi_rma_ping_pong") + ["fence"],noop)
+	run_experiment(args, "Ping_pong: EMPI (structs)", make_minibench_command(args, "ping_pong/empi_struct_ping_pong"),noop)
 	args.num_proc = tmp
 
 	run_experiment(args, "Bidirectional ring: MPI", make_minibench_command(args, "bdring/mpi_bdring"),noop)
 	run_experiment(args, "Bidirectional ring: EMPI", make_minibench_command(args, "bdring/empi_bdring"),noop)
+	run_experiment(args, "Bidirectional ring: EMPI (persistent)", make_minibench_command(args, "bdring/empi_persistent_bdring"),noop)
+	run_experiment(args, "Bidirectional ring: EMPI (shared memory)", make_minibench_command(args, "bdring/empi_shared_bdring"),noop)
+
+	run_experiment(args, "Overlap %: EMPI", make_minibench_command(args, "overlap/empi_overlap"),noop)
+	run_experiment(args, "Overlap %: EMPI (progress thread)", make_minibench_command(args, "overlap/empi_overlap") + ["progress"],noop)
+
+	run_experiment(args, "Halo exchange: EMPI (pack)", make_minibench_command(args, "halo/empi_halo_pack"),noop)
+	run_experiment(args, "Halo exchange: EMPI (view)", make_minibench_command(args, "halo/empi_halo_view"),noop)
+	run_experiment(args, "Halo exchange: EMPI (cartesian)", make_minibench_command(args, "halo/empi_halo_cartesian"),noop)
+	run_experiment(args, "Halo exchange: EMPI (continuations)", make_minibench_command(args, "halo/empi_halo_then"),noop)
+	run_experiment(args, "Halo exchange: EMPI (senders)", make_minibench_command(args, "halo/empi_halo_senders"),noop)
 
 	run_experiment(args, "Allreduce: MPI", make_minibench_command(args, "all_reduce/mpi_allreduce"),noop)
 	run_experiment(args, "Allreduce: EMPI", make_minibench_command(args, "all_reduce/empi_allreduce"),noop)
+	run_experiment(args, "Allreduce: EMPI (persistent)", make_minibench_command(args, "all_reduce/empi_persistent_allreduce"),noop)
+	run_experiment(args, "Allreduce: EMPI (hierarchical)", make_minibench_command(args, "all_reduce/empi_hierarchical_allreduce"),noop)
+	run_experiment(args, "Allreduce: EMPI (tuned online)", make_minibench_command(args, "all_reduce/empi_tuned_allreduce"),noop)
+	run_experiment(args, "Allreduce: EMPI (lambda MINLOC)", make_minibench_command(args, "all_reduce/empi_lambda_allreduce"),noop)
+	for segment in ["16384", "65536", "262144"]:
+		run_experiment(args, f"Allreduce: EMPI (ring, {segment} B segments)", make_minibench_command(args, "all_reduce/empi_ring_allreduce") + [segment],noop)
+
+	run_experiment(args, "IAllreduce: MPI", make_minibench_command(args, "iallreduce/mpi_iallreduce"),noop)
+	run_experiment(args, "IAllreduce: EMPI", make_minibench_command(args, "iallreduce/empi_iallreduce"),noop)
+
+	run_experiment(args, "IAlltoall: MPI", make_minibench_command(args, "ialltoall/mpi_ialltoall"),noop)
+	run_experiment(args, "IAlltoall: EMPI", make_minibench_command(args, "ialltoall/empi_ialltoall"),noop)
+
+	run_experiment(args, "Message rate: EMPI", make_minibench_command(args, "msg_rate/empi_msg_rate"),noop)
+	run_experiment(args, "Message rate: EMPI (aggregated)", make_minibench_command(args, "msg_rate/empi_aggregated_msg_rate"),noop)
 
 	run_experiment(args, "IBcast: MPI", make_minibench_command(args, "ibcast/mpi_ibcast"),noop)
 	run_experiment(args, "IBcast: EMPI", make_minibench_command(args, "ibcast/empi_ibcast"),noop)
 
 	run_experiment(args, "Bcast: MPI", make_minibench_command(args, "bcast/mpi_bcast"),noop)
-	run_experiment(args, "Bcast: EMPI", make_minibench_command(args, "bcast/empi_bcast"),noop)
\ No newline at end of file
+	run_experiment(args, "Bcast: EMPI", make_minibench_command(args, "bcast/empi_bcast"),noop)
+	run_experiment(args, "Bcast: EMPI (persistent)", make_minibench_command(args, "bcast/empi_persistent_bcast"),noop)
+	run_experiment(args, "Bcast: EMPI (hierarchical)", make_minibench_command(args, "bcast/empi_hierarchical_bcast"),noop)
+	run_experiment(args, "Bcast: EMPI (tuned online)", make_minibench_command(args, "bcast/empi_tuned_bcast"),noop)
+	for algorithm in ["chain", "tree"]:
+		for segment in ["16384", "65536", "262144"]:
+			run_experiment(args, f"Bcast: EMPI ({algorithm}, {segment} B segments)", make_minibench_command(args, "bcast/empi_pipelined_bcast") + [algorithm, segment],noop)
\ No newline at end of file
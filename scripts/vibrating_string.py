@@ -18,3 +18,4 @@ if __name__ == '__main__':
 	
 	run_experiment(args, "Vibrating String: MPI", make_minibench_command(args, "vibrating_string/mpi_vibrating_string"),noop)
 	run_experiment(args, "Vibrating String: EMPI", make_minibench_command(args, "vibrating_string/empi_vibrating_string"),noop)
+	run_experiment(args, "Vibrating String: EMPI (coroutines)", make_minibench_command(args, "vibrating_string/empi_coroutine_vibrating_string"),noop)